@@ -5,11 +5,13 @@
 #include "../common/BattleInfo.h"
 #include "../common/ActionRequest.h"
 #include "../UserCommon/Utils_212934582_323964676.h"  // For Direction and DirectionUtils
+#include "../UserCommon/SharedGrid_212934582_323964676.h"
+#include "FiringDistanceField_212934582_323964676.h"
 #include <vector>
 #include <string>
-#include <queue>
+#include <cstdint>
 #include <utility>
-#include <climits>
+#include <memory>
 
 namespace Algorithm_212934582_323964676 {
 
@@ -37,27 +39,12 @@ private:
     size_t                         _shellsRemaining;  // how many shells left
     bool                           _gotBattleInfo;    // whether we've received fresh info
 
-    std::vector<std::string>       _board;            // last round snapshot of entire map
-    std::vector<std::pair<int,int>> _enemyPositions;   // coordinates of all alive enemies
-    std::vector<std::pair<int,int>> _currentPath;      // cached BFS path: sequence of (r,c) from next move to shooting cell
+    UserCommon_212934582_323964676::GridSnapshot _board;  // last round snapshot of entire map (shared, read-only)
 
-    // Scan _board to populate _enemyPositions.
-    void findEnemies();
-
-    // Return true if cell (r,c) is not passable (wall '#', mine '@', or any tank '1'/'2').
-    bool isCellBlocked(int r, int c) const;
-
-    bool hasLineOfSight(int fromR, int fromC, int toR, int toC) const;
-
-    Direction directionBetween(int fromR, int fromC, int toR, int toC) const;
-
-    bool isValidDiagonal(int r, int c, int nr, int nc) const;
-
-    // Run a BFS from (_x,_y) to find the nearest cell from which we can see any enemy.
-    // If found, populate _currentPath with the sequence of coordinates (excluding (_x,_y)):
-    //   step 0 = first move‐to cell, …, last move = final shooting cell.
-    // Otherwise, leave _currentPath empty.
-    void computePathToNearestEnemy();
+    // Where the next action comes from: the field our player shares between its
+    // tanks, or one of our own when the battle info carries none
+    std::shared_ptr<FiringDistanceField_212934582_323964676> _field;
+    bool                           _ownsField;        // whether _field is private (fed from our battle info)
 
 public:
     void setDirection(Direction d) { _direction = d; }
@@ -0,0 +1,262 @@
+#include "ClusterGraph_212934582_323964676.h"
+#include "StaticMapAnalysis_212934582_323964676.h"
+#include "../UserCommon/Utils_212934582_323964676.h"  // For Direction and DirectionUtils
+#include <algorithm>
+
+namespace Algorithm_212934582_323964676 {
+
+using UserCommon_212934582_323964676::Direction;
+using UserCommon_212934582_323964676::DirectionUtils;
+
+namespace {
+
+// Runs of open cells along a border at least this long get an entrance at
+// each end rather than one in the middle, so that routes need not detour
+constexpr size_t LONG_RUN = 6;
+
+// The step from a cell in direction d, in cells
+ptrdiff_t stepOffset(Direction d, size_t cols) {
+    auto [dr, dc] = DirectionUtils::toVector(d);
+    return static_cast<ptrdiff_t>(dr) * static_cast<ptrdiff_t>(cols) + dc;
+}
+
+} // namespace
+
+ClusterGraph_212934582_323964676::ClusterGraph_212934582_323964676(const StaticMapAnalysis_212934582_323964676& layout)
+    : _rows(layout.rows())
+    , _cols(layout.cols())
+    , _clusterRows((_rows + CLUSTER_SIZE - 1) / CLUSTER_SIZE)
+    , _clusterCols((_cols + CLUSTER_SIZE - 1) / CLUSTER_SIZE)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> crossings;
+    labelRegions(layout);
+    placeEntrances(layout, crossings);
+    linkEntrances(layout, crossings);
+}
+
+uint32_t ClusterGraph_212934582_323964676::entranceAt(uint32_t cell) const {
+    const size_t cluster = clusterOf(cell);
+    auto first = _entranceCell.begin() + _clusterEntrances[cluster];
+    auto last = _entranceCell.begin() + _clusterEntrances[cluster + 1];
+    return static_cast<uint32_t>(std::lower_bound(first, last, cell) - _entranceCell.begin());
+}
+
+void ClusterGraph_212934582_323964676::labelRegions(const StaticMapAnalysis_212934582_323964676& layout) {
+    _region.assign(_rows * _cols, NO_REGION);
+    std::vector<uint32_t> queue;
+    uint32_t next = 0;
+    for (size_t r = 0; r < _rows; ++r) {
+        for (size_t c = 0; c < _cols; ++c) {
+            const uint32_t cell = static_cast<uint32_t>(r * _cols + c);
+            if (layout.isStatic(r, c) || _region[cell] != NO_REGION) continue;
+            const uint32_t label = next++;
+            const size_t cluster = clusterOf(cell);
+            _region[cell] = label;
+            queue.assign(1, cell);
+            for (size_t i = 0; i < queue.size(); ++i) {
+                for (int d = 0; d < 8; ++d) {
+                    const Direction dir = static_cast<Direction>(d);
+                    if (!layout.canStep(queue[i], dir)) continue;
+                    const uint32_t to = static_cast<uint32_t>(queue[i] + stepOffset(dir, _cols));
+                    if (_region[to] == NO_REGION && clusterOf(to) == cluster) {
+                        _region[to] = label;
+                        queue.push_back(to);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Along every border, the pairs of open cells facing each other form runs;
+// each run is crossed in the middle, or at both ends when it is long
+void ClusterGraph_212934582_323964676::placeEntrances(const StaticMapAnalysis_212934582_323964676& layout,
+                                                      std::vector<std::pair<uint32_t, uint32_t>>& crossings) {
+    auto scan = [&](size_t length, auto pairAt) {
+        size_t begin = 0;
+        auto close = [&](size_t end) {
+            if (end <= begin) return;
+            if (end - begin < LONG_RUN) {
+                crossings.push_back(pairAt((begin + end - 1) / 2));
+            } else {
+                crossings.push_back(pairAt(begin));
+                crossings.push_back(pairAt(end - 1));
+            }
+        };
+        for (size_t i = 0; i < length; ++i) {
+            auto [a, b] = pairAt(i);
+            bool open = !layout.isStatic(a / _cols, a % _cols) && !layout.isStatic(b / _cols, b % _cols);
+            if (!open || i % CLUSTER_SIZE == 0) {
+                close(i);
+                begin = open ? i : i + 1;
+            }
+        }
+        close(length);
+    };
+    for (size_t c = CLUSTER_SIZE; c < _cols; c += CLUSTER_SIZE) {
+        scan(_rows, [&](size_t r) {
+            return std::make_pair(static_cast<uint32_t>(r * _cols + c - 1), static_cast<uint32_t>(r * _cols + c));
+        });
+    }
+    for (size_t r = CLUSTER_SIZE; r < _rows; r += CLUSTER_SIZE) {
+        scan(_cols, [&](size_t c) {
+            return std::make_pair(static_cast<uint32_t>((r - 1) * _cols + c), static_cast<uint32_t>(r * _cols + c));
+        });
+    }
+
+    // Number the entrances by cluster, then cell
+    std::vector<uint64_t> keys;
+    keys.reserve(2 * crossings.size());
+    for (const auto& [a, b] : crossings) {
+        keys.push_back(static_cast<uint64_t>(clusterOf(a)) << 32 | a);
+        keys.push_back(static_cast<uint64_t>(clusterOf(b)) << 32 | b);
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    _entranceCell.resize(keys.size());
+    _clusterEntrances.assign(_clusterRows * _clusterCols + 1, 0);
+    for (size_t e = 0; e < keys.size(); ++e) {
+        _entranceCell[e] = static_cast<uint32_t>(keys[e]);
+        ++_clusterEntrances[(keys[e] >> 32) + 1];
+    }
+    for (size_t k = 1; k < _clusterEntrances.size(); ++k) {
+        _clusterEntrances[k] += _clusterEntrances[k - 1];
+    }
+}
+
+// Inside a cluster, the fewest actions from an entrance (facing anywhere) to
+// each other one, by a breadth-first search over (cell, facing). A tank may
+// move backwards as well as forwards, so facing d and facing d + 180 always
+// cost the same here: only the axis matters. One rotation turns to any other
+// axis, so a cell reached first (on some axes) after n actions has every other
+// axis after n + 1: the search visits each cell twice, once for the axes it
+// was reached on and once for the rest. Every action can be undone, so the
+// cost between two entrances is the same both ways, and each search only looks
+// for the entrances numbered after its own.
+void ClusterGraph_212934582_323964676::linkEntrances(const StaticMapAnalysis_212934582_323964676& layout,
+                                                     const std::vector<std::pair<uint32_t, uint32_t>>& crossings) {
+    std::vector<std::pair<uint32_t, Link>> links;
+    for (const auto& [a, b] : crossings) {
+        links.push_back({entranceAt(a), {entranceAt(b), 1}});
+        links.push_back({entranceAt(b), {entranceAt(a), 1}});
+    }
+
+    // Cells of a cluster are numbered r * CLUSTER_SIZE + c inside it
+    constexpr size_t S = CLUSTER_SIZE;
+    constexpr uint16_t UNREACHED = UINT16_MAX;
+    constexpr uint16_t ALL_AXES = 0xF;
+    ptrdiff_t localStep[8];
+    for (int d = 0; d < 8; ++d) {
+        auto [dr, dc] = DirectionUtils::toVector(static_cast<Direction>(d));
+        localStep[d] = dr * static_cast<ptrdiff_t>(S) + dc;
+    }
+    std::vector<uint8_t> moves(S * S);       // per cell, bit d: a step in direction d stays in the cluster
+    std::vector<uint16_t> dist(S * S);       // per cell, the fewest actions to it
+    std::vector<uint8_t> axes(S * S);        // per cell, the axes reached after dist actions
+    std::vector<uint16_t> queue(2 * S * S);  // cell * 2, + 1 for the visit of its other axes
+    std::vector<uint32_t> target(S * S, 0);  // per cell, the search that looks for an entrance on it
+    std::vector<uint32_t> regions;           // of the cluster's entrances
+    uint32_t search = 0;
+    for (size_t cluster = 0; cluster + 1 < _clusterEntrances.size(); ++cluster) {
+        const uint32_t firstEntrance = _clusterEntrances[cluster];
+        const uint32_t lastEntrance = _clusterEntrances[cluster + 1];
+        if (lastEntrance - firstEntrance < 2) continue;
+        const size_t r0 = cluster / _clusterCols * S;
+        const size_t c0 = cluster % _clusterCols * S;
+        for (size_t lr = 0; lr < S; ++lr) {
+            for (size_t lc = 0; lc < S; ++lc) {
+                uint8_t bits = 0;
+                const size_t r = r0 + lr, c = c0 + lc;
+                if (r < _rows && c < _cols && !layout.isStatic(r, c)) {
+                    for (int d = 0; d < 8; ++d) {
+                        auto [dr, dc] = DirectionUtils::toVector(static_cast<Direction>(d));
+                        const size_t tr = lr + dr, tc = lc + dc;  // wraps past S when leaving at the top or left
+                        if (tr < S && tc < S && layout.canStep(r * _cols + c, static_cast<Direction>(d))) {
+                            bits |= static_cast<uint8_t>(1u << d);
+                        }
+                    }
+                }
+                moves[lr * S + lc] = bits;
+            }
+        }
+        auto localCell = [&](uint32_t entrance) {
+            const uint32_t cell = _entranceCell[entrance];
+            return static_cast<uint16_t>((cell / _cols - r0) * S + cell % _cols - c0);
+        };
+        regions.clear();
+        for (uint32_t e = firstEntrance; e < lastEntrance; ++e) {
+            regions.push_back(_region[_entranceCell[e]]);
+        }
+        auto sameRegion = [&](uint32_t a, uint32_t b) {
+            return regions[a - firstEntrance] == regions[b - firstEntrance];
+        };
+
+        for (uint32_t from = firstEntrance; from + 1 < lastEntrance; ++from) {
+            ++search;
+            size_t targets = 0;
+            for (uint32_t to = from + 1; to < lastEntrance; ++to) {
+                if (sameRegion(from, to)) {
+                    target[localCell(to)] = search;
+                    ++targets;
+                }
+            }
+            if (targets == 0) continue;
+            std::fill(dist.begin(), dist.end(), UNREACHED);
+            const uint16_t start = localCell(from);
+            dist[start] = 0;
+            axes[start] = ALL_AXES;
+            size_t head = 0, tail = 0;
+            queue[tail++] = static_cast<uint16_t>(start * 2);
+            size_t found = 0;
+            while (head < tail && found < targets) {
+                const uint16_t visit = queue[head++];
+                const uint16_t local = visit / 2;
+                const bool rotated = visit % 2 != 0;
+                const uint16_t next = static_cast<uint16_t>(dist[local] + (rotated ? 2 : 1));
+                const uint8_t moving = rotated ? static_cast<uint8_t>(ALL_AXES & ~axes[local]) : axes[local];
+                if (!rotated && moving != ALL_AXES) {
+                    queue[tail++] = static_cast<uint16_t>(visit + 1);
+                }
+                // steps along the moving axes, either way
+                for (unsigned steps = moves[local] & (moving | moving << 4u); steps != 0; steps &= steps - 1) {
+                    const int d = __builtin_ctz(steps);
+                    const uint16_t to = static_cast<uint16_t>(local + localStep[d]);
+                    if (dist[to] == UNREACHED) {
+                        dist[to] = next;
+                        axes[to] = 0;
+                        queue[tail++] = static_cast<uint16_t>(to * 2);
+                        if (target[to] == search) {
+                            ++found;
+                        }
+                    }
+                    if (dist[to] == next) {
+                        axes[to] |= static_cast<uint8_t>(1u << (d % 4));
+                    }
+                }
+            }
+            for (uint32_t to = from + 1; to < lastEntrance; ++to) {
+                const uint16_t cost = dist[localCell(to)];
+                if (cost != UNREACHED && sameRegion(from, to)) {
+                    links.push_back({from, {to, cost}});
+                    links.push_back({to, {from, cost}});
+                }
+            }
+        }
+    }
+
+    // Group the links by entrance, each keeping the order it was found in
+    _linkOffsets.assign(_entranceCell.size() + 1, 0);
+    for (const auto& [from, link] : links) {
+        ++_linkOffsets[from + 1];
+    }
+    for (size_t e = 1; e < _linkOffsets.size(); ++e) {
+        _linkOffsets[e] += _linkOffsets[e - 1];
+    }
+    std::vector<uint32_t> fill(_linkOffsets.begin(), _linkOffsets.end() - 1);
+    _links.resize(links.size());
+    for (const auto& [from, link] : links) {
+        _links[fill[from]++] = link;
+    }
+}
+
+} // namespace Algorithm_212934582_323964676
@@ -0,0 +1,71 @@
+#ifndef CLUSTERGRAPH_212934582_323964676_H
+#define CLUSTERGRAPH_212934582_323964676_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace Algorithm_212934582_323964676 {
+
+class StaticMapAnalysis_212934582_323964676;
+
+// An abstract graph for routing across large maps (HPA*). The map is cut into
+// CLUSTER_SIZE x CLUSTER_SIZE clusters. Where open cells face each other across
+// a cluster border, an entrance is placed on each side of the run (two for a
+// long run), linked to the one across by a single step; inside a cluster, each
+// entrance is linked to every other it can reach there by the fewest actions,
+// turns included. A region is a part of one cluster connected inside it.
+// Built from walls and mines only, like the StaticMapAnalysis that owns it;
+// immutable once built. Cells are r * cols + c.
+class ClusterGraph_212934582_323964676 {
+public:
+    static constexpr size_t CLUSTER_SIZE = 16;
+    // Maps with fewer cells are searched cell by cell; no graph is built
+    static constexpr size_t MIN_CELLS = 250000;
+    static constexpr uint32_t NO_REGION = UINT32_MAX;  // walls and mines
+
+    struct Link {
+        uint32_t to;    // entrance
+        uint32_t cost;  // actions
+    };
+
+    explicit ClusterGraph_212934582_323964676(const StaticMapAnalysis_212934582_323964676& layout);
+
+    size_t clusterRows() const { return _clusterRows; }
+    size_t clusterCols() const { return _clusterCols; }
+    size_t clusterOf(size_t r, size_t c) const { return (r / CLUSTER_SIZE) * _clusterCols + c / CLUSTER_SIZE; }
+
+    uint32_t region(size_t cell) const { return _region[cell]; }
+
+    size_t entranceCount() const { return _entranceCell.size(); }
+    uint32_t entranceCell(uint32_t entrance) const { return _entranceCell[entrance]; }
+    // The entrances of a cluster are numbered firstEntrance(k) to
+    // firstEntrance(k + 1) - 1, by cell
+    uint32_t firstEntrance(size_t cluster) const { return _clusterEntrances[cluster]; }
+
+    const Link* linksBegin(uint32_t entrance) const { return _links.data() + _linkOffsets[entrance]; }
+    const Link* linksEnd(uint32_t entrance) const { return _links.data() + _linkOffsets[entrance + 1]; }
+
+private:
+    size_t                         _rows, _cols;
+    size_t                         _clusterRows, _clusterCols;
+    std::vector<uint32_t>          _region;           // per cell, NO_REGION for walls and mines
+    std::vector<uint32_t>          _entranceCell;     // by cluster, then cell
+    std::vector<uint32_t>          _clusterEntrances; // per cluster, its first entrance; one more at the end
+    std::vector<uint32_t>          _linkOffsets;      // per entrance, its first link; one more at the end
+    std::vector<Link>              _links;
+
+    size_t clusterOf(size_t cell) const { return clusterOf(cell / _cols, cell % _cols); }
+    uint32_t entranceAt(uint32_t cell) const;
+
+    void labelRegions(const StaticMapAnalysis_212934582_323964676& layout);
+    void placeEntrances(const StaticMapAnalysis_212934582_323964676& layout,
+                        std::vector<std::pair<uint32_t, uint32_t>>& crossings);
+    void linkEntrances(const StaticMapAnalysis_212934582_323964676& layout,
+                       const std::vector<std::pair<uint32_t, uint32_t>>& crossings);
+};
+
+} // namespace Algorithm_212934582_323964676
+
+#endif // CLUSTERGRAPH_212934582_323964676_H
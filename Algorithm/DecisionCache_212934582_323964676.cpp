@@ -0,0 +1,74 @@
+#include "DecisionCache_212934582_323964676.h"
+
+namespace Algorithm_212934582_323964676 {
+
+DecisionCache_212934582_323964676::DecisionCache_212934582_323964676(size_t capacity) {
+    const size_t perStripe = capacity / STRIPES > 0 ? capacity / STRIPES : 1;
+    for (auto& stripe : _stripes) {
+        stripe.slots.assign(perStripe, Slot{Key{0, 0, 0, 0, 0}, ActionRequest::DoNothing, false});
+    }
+}
+
+DecisionCache_212934582_323964676* DecisionCache_212934582_323964676::shared() {
+    if constexpr (AGGRESSIVE_DECISION_CACHE_ENTRIES == 0) {
+        return nullptr;
+    } else {
+        static DecisionCache_212934582_323964676 cache(AGGRESSIVE_DECISION_CACHE_ENTRIES);
+        return &cache;
+    }
+}
+
+// splitmix64 steps over the key's fields; the low bits pick the stripe, the
+// rest the slot
+uint64_t DecisionCache_212934582_323964676::hashOf(const Key& key) {
+    auto mix = [](uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    };
+    uint64_t h = mix(key.board + 0x9E3779B97F4A7C15ULL);
+    h = mix(h ^ (static_cast<uint64_t>(key.rows) << 32 | key.cols));
+    h = mix(h ^ (static_cast<uint64_t>(key.state) << 8 | static_cast<uint8_t>(key.player)));
+    return h;
+}
+
+bool DecisionCache_212934582_323964676::find(const Key& key, ActionRequest& action) {
+    const uint64_t h = hashOf(key);
+    Stripe& stripe = _stripes[h % STRIPES];
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    const Slot& slot = stripe.slots[(h / STRIPES) % stripe.slots.size()];
+    if (slot.used && slot.key == key) {
+        action = slot.action;
+        ++stripe.hits;
+        return true;
+    }
+    ++stripe.misses;
+    return false;
+}
+
+void DecisionCache_212934582_323964676::store(const Key& key, ActionRequest action) {
+    const uint64_t h = hashOf(key);
+    Stripe& stripe = _stripes[h % STRIPES];
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    stripe.slots[(h / STRIPES) % stripe.slots.size()] = Slot{key, action, true};
+}
+
+uint64_t DecisionCache_212934582_323964676::hits() const {
+    uint64_t total = 0;
+    for (const auto& stripe : _stripes) {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        total += stripe.hits;
+    }
+    return total;
+}
+
+uint64_t DecisionCache_212934582_323964676::misses() const {
+    uint64_t total = 0;
+    for (const auto& stripe : _stripes) {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        total += stripe.misses;
+    }
+    return total;
+}
+
+} // namespace Algorithm_212934582_323964676
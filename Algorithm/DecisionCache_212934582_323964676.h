@@ -0,0 +1,78 @@
+#ifndef DECISIONCACHE_212934582_323964676_H
+#define DECISIONCACHE_212934582_323964676_H
+
+#include "../common/ActionRequest.h"
+#include <array>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Decisions the Aggressive library remembers across games; 0 turns the cache off
+#ifndef AGGRESSIVE_DECISION_CACHE_ENTRIES
+#define AGGRESSIVE_DECISION_CACHE_ENTRIES 65536
+#endif
+
+namespace Algorithm_212934582_323964676 {
+
+// A bounded transposition table of tank decisions, shared by every game and
+// thread in the process. A deterministic algorithm always answers the same
+// board, player and tank state with the same action, so a repeat (a tank
+// turning while nothing else moves, the same opening in every game on a map)
+// skips planning. The table is split into STRIPES, each behind its own lock;
+// a key has one slot in its stripe, and a new decision replaces whatever held
+// it. Boards are told apart by a 64-bit hash.
+class DecisionCache_212934582_323964676 {
+public:
+    struct Key {
+        uint64_t board;   // FiringDistanceField::boardHash()
+        uint32_t rows, cols;
+        uint32_t state;   // (r * cols + c) * 8 + direction
+        int      player;
+
+        bool operator==(const Key& other) const {
+            return board == other.board && rows == other.rows && cols == other.cols &&
+                   state == other.state && player == other.player;
+        }
+    };
+
+    // `capacity` slots in all, at least one per stripe
+    explicit DecisionCache_212934582_323964676(size_t capacity);
+
+    // The cache of this library, of AGGRESSIVE_DECISION_CACHE_ENTRIES slots;
+    // null when that is 0
+    static DecisionCache_212934582_323964676* shared();
+
+    // The action stored for `key`, if any
+    bool find(const Key& key, ActionRequest& action);
+    void store(const Key& key, ActionRequest action);
+
+    // Lookups so far that found, or did not find, their key
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+private:
+    static constexpr size_t STRIPES = 16;
+
+    struct Slot {
+        Key           key;
+        ActionRequest action;
+        bool          used;
+    };
+    // The counters live with the slots and are bumped under the same lock, so
+    // a lookup touches no memory shared with other stripes
+    struct alignas(64) Stripe {
+        mutable std::mutex mutex;
+        std::vector<Slot>  slots;
+        uint64_t           hits = 0;
+        uint64_t           misses = 0;
+    };
+
+    std::array<Stripe, STRIPES>    _stripes;
+
+    static uint64_t hashOf(const Key& key);
+};
+
+} // namespace Algorithm_212934582_323964676
+
+#endif // DECISIONCACHE_212934582_323964676_H
@@ -0,0 +1,295 @@
+#include "EvasiveTankAI_212934582_323964676.h"
+#include "../UserCommon/MyBattleInfo_212934582_323964676.h"
+#include "../common/TankAlgorithmRegistration.h"
+#include "../UserCommon/BoardScan_212934582_323964676.h"
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdlib>
+
+namespace Algorithm_212934582_323964676 {
+
+using UserCommon_212934582_323964676::MyBattleInfo;
+using UserCommon_212934582_323964676::ThreatMap;
+using UserCommon_212934582_323964676::BoardScan;
+using UserCommon_212934582_323964676::CharSet;
+using UserCommon_212934582_323964676::directionTowards;
+using UserCommon_212934582_323964676::rotationCost;
+
+namespace {
+
+constexpr size_t SHELL_HORIZON = 3;     // steps ahead a shell in flight is feared
+constexpr int PATIENCE = 20;            // turns without progress before taking a duel
+constexpr uint32_t FAR = UINT32_MAX;    // no line to an enemy reachable
+
+// Walls, mines and tanks: they stop shots, and tanks cannot enter them
+const CharSet BLOCKING("#@12");
+
+// Bits of _cells
+constexpr uint8_t PASSABLE = 1;         // a tank may enter (our own cell counts)
+constexpr uint8_t ON_LINE = 2;          // an enemy has a line to it
+
+// Score terms; dangers outweigh everything else
+constexpr int SHELL_PENALTY = 1000;     // divided by the steps until a shell may arrive
+constexpr int EXPOSED_PENALTY = 150;    // per enemy line we could not answer next turn
+constexpr int READY_BONUS = 200;        // on a line, facing the enemy: we fire next turn
+constexpr int DUEL_BONUS = 50;          // on a line, one rotation from firing (after PATIENCE)
+constexpr int STEP_COST = 4;            // per move from the nearest line
+constexpr int FACING_BONUS = 3;         // turned toward the nearest enemy while waiting
+
+// Actions in order of preference when scores tie
+constexpr std::array<ActionRequest, 7> CANDIDATES = {
+    ActionRequest::DoNothing,
+    ActionRequest::MoveForward,
+    ActionRequest::RotateLeft45,
+    ActionRequest::RotateRight45,
+    ActionRequest::RotateLeft90,
+    ActionRequest::RotateRight90,
+    ActionRequest::MoveBackward,
+};
+
+} // namespace
+
+EvasiveTankAI_212934582_323964676::EvasiveTankAI_212934582_323964676(int playerIndex, int tankIndex)
+    : _playerIndex(playerIndex)
+    , _tankIndex(tankIndex)
+    , _own(playerIndex)
+    , _x(0)
+    , _y(0)
+    , _rows(0)
+    , _cols(0)
+    , _gotBattleInfo(false)
+    , _waited(0)
+    , _stamp(0)
+    , _enemyRow(-1)
+    , _enemyCol(-1)
+{
+}
+
+void EvasiveTankAI_212934582_323964676::updateBattleInfo(BattleInfo& info) {
+    auto& bi = static_cast<MyBattleInfo&>(info);
+
+    _rows  = bi.rows;
+    _cols  = bi.cols;
+    _board = bi.board;
+    _x     = bi.x;  // row
+    _y     = bi.y;  // column
+    _own.onBattleInfo(bi.shells_remaining);
+    _gotBattleInfo = true;
+}
+
+ActionRequest EvasiveTankAI_212934582_323964676::getAction() {
+    if (!_gotBattleInfo) {
+        return ActionRequest::GetBattleInfo;
+    }
+    _gotBattleInfo = false;
+
+    const int r = static_cast<int>(_x);
+    const int c = static_cast<int>(_y);
+    if (r < 0 || c < 0 || r >= static_cast<int>(_rows) || c >= static_cast<int>(_cols)) {
+        return ActionRequest::DoNothing;
+    }
+
+    const Direction facing = _own.direction();
+    if (_own.shells() > 0 && canShootFrom(r, c, facing)) {
+        _own.apply(ActionRequest::Shoot, true);
+        _waited = 0;
+        return ActionRequest::Shoot;
+    }
+
+    _threats.build(*_board, _playerIndex, SHELL_HORIZON, r, c);
+    readBoard();
+
+    // Every candidate is one O(1) look-up in the threat map; the distance to a
+    // line is searched for at most three cells, and none beyond our own
+    // cell's when no line can be reached from there
+    const uint32_t hereDistance = lineDistance(r, c);
+    ActionRequest best = ActionRequest::DoNothing;
+    int bestScore = INT_MIN;
+    uint32_t bestDistance = hereDistance;
+    for (ActionRequest action : CANDIDATES) {
+        int nr = r, nc = c;
+        Direction nd = facing;
+        switch (action) {
+            case ActionRequest::RotateLeft45:  nd = DirectionUtils::rotate45ccw(facing); break;
+            case ActionRequest::RotateRight45: nd = DirectionUtils::rotate45cw(facing); break;
+            case ActionRequest::RotateLeft90:  nd = DirectionUtils::rotate90(facing, false); break;
+            case ActionRequest::RotateRight90: nd = DirectionUtils::rotate90(facing, true); break;
+            case ActionRequest::MoveForward:
+            case ActionRequest::MoveBackward: {
+                Direction step = action == ActionRequest::MoveForward ? facing : DirectionUtils::rotate180(facing);
+                if (!canStep(r, c, step)) continue;
+                auto [dr, dc] = DirectionUtils::toVector(step);
+                nr += dr;
+                nc += dc;
+                break;
+            }
+            default:
+                break;
+        }
+        uint32_t distance = hereDistance;
+        if ((nr != r || nc != c) && hereDistance != FAR) {
+            distance = lineDistance(nr, nc);
+        }
+        int s = score(nr, nc, nd, distance);
+        if (s > bestScore) {
+            bestScore = s;
+            best = action;
+            bestDistance = distance;
+        }
+    }
+
+    _waited = bestDistance < hereDistance ? 0 : _waited + 1;
+    _own.apply(best, false);
+    return best;
+}
+
+// Off the map, wall, mine or a tank other than ours (we are about to move)
+bool EvasiveTankAI_212934582_323964676::isCellBlocked(int r, int c) const {
+    if (r < 0 || c < 0 || r >= static_cast<int>(_rows) || c >= static_cast<int>(_cols)) {
+        return true;
+    }
+    return !(_cells[(static_cast<size_t>(r) + 1) * (_cols + 2) + c + 1] & PASSABLE);
+}
+
+bool EvasiveTankAI_212934582_323964676::canStep(int r, int c, Direction d) const {
+    auto [dr, dc] = DirectionUtils::toVector(d);
+    if (isCellBlocked(r + dr, c + dc)) return false;
+    return dr == 0 || dc == 0 || (!isCellBlocked(r, c + dc) && !isCellBlocked(r + dr, c));
+}
+
+bool EvasiveTankAI_212934582_323964676::canShootFrom(int r, int c, Direction d) const {
+    auto [dr, dc] = DirectionUtils::toVector(d);
+    const int steps = static_cast<int>(BoardScan::rayLength(*_board, r, c, dr, dc, BLOCKING));
+    if (steps == 0) {
+        return false;
+    }
+    // The last cell of the ray is what the shot hits, if it hits anything
+    const char enemy = _playerIndex == 1 ? '2' : '1';
+    return (*_board)[r + steps * dr][c + steps * dc] == enemy;
+}
+
+int EvasiveTankAI_212934582_323964676::turnsToFire(int r, int c, Direction d) const {
+    int best = -1;
+    uint8_t bits = _threats.lineDirections(r, c);
+    for (int e = 0; e < 8; ++e) {
+        if (!(bits >> e & 1u)) continue;
+        // A shot travelling in e reaches us, so its shooter is the other way
+        int turns = rotationCost(d, DirectionUtils::rotate180(static_cast<Direction>(e)));
+        if (best < 0 || turns < best) {
+            best = turns;
+        }
+    }
+    return best;
+}
+
+void EvasiveTankAI_212934582_323964676::readBoard() {
+    const size_t width = _cols + 2;
+    int nearest = INT_MAX;
+    _enemyRow = _enemyCol = -1;
+    const CharSet enemies(_playerIndex == 1 ? "2" : "1");
+    _cells.assign((_rows + 2) * width, 0);
+    for (size_t r = 0; r < _rows; ++r) {
+        const std::string& line = (*_board)[r];
+        uint8_t* cells = &_cells[(r + 1) * width + 1];
+        // 1 on blocked cells, flipped to PASSABLE on the others
+        BoardScan::markMembers(line.data(), _cols, BLOCKING, cells);
+        for (size_t c = 0; c < _cols; ++c) {
+            cells[c] = static_cast<uint8_t>((cells[c] ^ PASSABLE) | (_threats.lineDirections(r, c) ? ON_LINE : 0));
+        }
+        BoardScan::forEach(line.data(), _cols, enemies, [&](size_t c) {
+            int dist = std::max(std::abs(static_cast<int>(r) - static_cast<int>(_x)),
+                                std::abs(static_cast<int>(c) - static_cast<int>(_y)));
+            if (dist < nearest) {
+                nearest = dist;
+                _enemyRow = static_cast<int>(r);
+                _enemyCol = static_cast<int>(c);
+            }
+        });
+    }
+    // We are the one moving, so our own cell is free
+    _cells[(_x + 1) * width + _y + 1] |= PASSABLE;
+}
+
+// Breadth-first along legal steps, stopping at the first cell an enemy has a
+// line to, so the search only covers the cells closer than that one
+uint32_t EvasiveTankAI_212934582_323964676::lineDistance(int r, int c) {
+    const int width = static_cast<int>(_cols) + 2;
+    if (_seen.size() != _cells.size() || ++_stamp == 0) {
+        _seen.assign(_cells.size(), 0);
+        _stamp = 1;
+    }
+    // Padded index offsets of the 8 steps, and of the two cells a diagonal
+    // step passes between (the corner-cut rule)
+    int step[8], sideRow[8], sideCol[8];
+    for (int d = 0; d < 8; ++d) {
+        auto [dr, dc] = DirectionUtils::toVector(static_cast<Direction>(d));
+        step[d] = dr * width + dc;
+        sideRow[d] = dr * width;
+        sideCol[d] = dc;
+    }
+
+    _frontier.clear();
+    const uint32_t start = static_cast<uint32_t>((r + 1) * width + c + 1);
+    _seen[start] = _stamp;
+    _frontier.push_back(start);
+    uint32_t distance = 0;
+    size_t levelEnd = _frontier.size();
+    for (size_t i = 0; i < _frontier.size(); ++i) {
+        if (i == levelEnd) {
+            ++distance;
+            levelEnd = _frontier.size();
+        }
+        const uint32_t cell = _frontier[i];
+        if (_cells[cell] & ON_LINE) {
+            return distance;
+        }
+        for (int d = 0; d < 8; ++d) {
+            uint32_t next = cell + step[d];
+            if (!(_cells[next] & PASSABLE) || _seen[next] == _stamp) continue;
+            if (sideRow[d] != 0 && sideCol[d] != 0 &&
+                !(_cells[cell + sideRow[d]] & _cells[cell + sideCol[d]] & PASSABLE)) continue;
+            _seen[next] = _stamp;
+            _frontier.push_back(next);
+        }
+    }
+    return FAR;
+}
+
+int EvasiveTankAI_212934582_323964676::score(int r, int c, Direction d, uint32_t distance) const {
+    int s = 0;
+    uint8_t eta = _threats.shellEta(r, c);
+    if (eta != ThreatMap::NO_SHELL) {
+        s -= SHELL_PENALTY / eta;
+    }
+
+    int lines = _threats.lines(r, c);
+    if (lines > 0) {
+        int turns = _own.shells() > 0 ? turnsToFire(r, c, d) : -1;
+        if (turns == 0) {
+            return s + READY_BONUS - EXPOSED_PENALTY * (lines - 1);
+        }
+        if (turns == 1 && _waited >= PATIENCE) {
+            return s + DUEL_BONUS - EXPOSED_PENALTY * (lines - 1);
+        }
+        return s - EXPOSED_PENALTY * lines;
+    }
+
+    s -= STEP_COST * (distance == FAR ? static_cast<int>(_rows + _cols) : static_cast<int>(distance));
+
+    // Face the nearest enemy, so that one stepping into our line can be shot first
+    Direction towards = d;
+    if (_enemyRow >= 0) {
+        towards = directionTowards(_enemyRow - r, _enemyCol - c);
+    }
+    if (towards == d) {
+        s += FACING_BONUS;
+    }
+    return s;
+}
+
+} // namespace Algorithm_212934582_323964676
+
+// Register the evasive tank algorithm implementation
+using EvasiveAI = Algorithm_212934582_323964676::EvasiveTankAI_212934582_323964676;
+REGISTER_TANK_ALGORITHM(EvasiveAI)
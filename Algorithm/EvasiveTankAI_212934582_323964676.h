@@ -0,0 +1,84 @@
+#ifndef EVASIVETANKAI_212934582_323964676_H
+#define EVASIVETANKAI_212934582_323964676_H
+
+#include "../common/TankAlgorithm.h"
+#include "../common/BattleInfo.h"
+#include "../common/ActionRequest.h"
+#include "../UserCommon/Utils_212934582_323964676.h"  // For Direction and DirectionUtils
+#include "../UserCommon/SharedGrid_212934582_323964676.h"
+#include "../UserCommon/ThreatMap_212934582_323964676.h"
+#include "../UserCommon/DeadReckoning_212934582_323964676.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Algorithm_212934582_323964676 {
+
+using UserCommon_212934582_323964676::Direction;
+using UserCommon_212934582_323964676::DirectionUtils;
+
+// Fights from cover. Every turn it builds a ThreatMap, then scores each action
+// by where it leaves the tank: shells about to arrive and enemy lines it could
+// not answer cost the most, being able to fire scores best, and otherwise it
+// closes in on the nearest cell with a line to an enemy (breadth-first, along
+// legal steps) and turns toward the nearest enemy so that one stepping into
+// its line can be shot at once. After waiting too long it accepts lines it can
+// answer with a single rotation.
+class EvasiveTankAI_212934582_323964676 : public TankAlgorithm {
+public:
+    EvasiveTankAI_212934582_323964676(int playerIndex, int tankIndex);
+    ~EvasiveTankAI_212934582_323964676() noexcept override = default;
+
+    // Return the next action for this tank
+    ActionRequest getAction() override;
+
+    // Receive fresh battle information at the start of a round
+    void updateBattleInfo(BattleInfo& info) override;
+
+private:
+    int                            _playerIndex;      // 1 for Player 1
+    int                            _tankIndex;        // zero-based index of this tank
+    UserCommon_212934582_323964676::DeadReckoning _own;  // our facing and shells
+    size_t                         _x, _y;            // current coordinates: _x=row, _y=column (HW2 convention)
+    size_t                         _rows, _cols;      // map dimensions
+    bool                           _gotBattleInfo;    // whether we've received fresh info
+    int                            _waited;           // turns since we last moved closer or shot
+    UserCommon_212934582_323964676::GridSnapshot _board;  // last round snapshot of entire map (shared, read-only)
+
+    UserCommon_212934582_323964676::ThreatMap _threats;
+    std::vector<uint8_t>           _cells;            // per cell this turn, padded with a blocked border: passable, on a line
+    std::vector<uint32_t>          _seen;             // per cell of _cells, the lineDistance search that last reached it
+    uint32_t                       _stamp;            // the current lineDistance search
+    std::vector<uint32_t>          _frontier;         // breadth-first queue for lineDistance, kept for its capacity
+    int                            _enemyRow, _enemyCol;  // nearest enemy this turn, -1 when none
+
+    // Return true if cell (r,c) is not passable (off the map, wall, mine or tank)
+    bool isCellBlocked(int r, int c) const;
+
+    // Whether a tank on (r,c) may step one cell in direction d (corner-cut rule)
+    bool canStep(int r, int c, Direction d) const;
+
+    // Whether a shot from (r,c) facing d would hit an enemy
+    bool canShootFrom(int r, int c, Direction d) const;
+
+    // Fewest rotations from facing d to one that fires at an enemy from (r,c),
+    // or -1, from the threat map
+    int turnsToFire(int r, int c, Direction d) const;
+
+    // Fills _cells from the board and the threat map, and finds the nearest enemy
+    void readBoard();
+
+    // Moves from (r,c) to the nearest cell with a line to an enemy, or UINT32_MAX when none can be reached
+    uint32_t lineDistance(int r, int c);
+
+    // How good it is to end this turn on (r,c) facing d, `distance` moves from a line
+    int score(int r, int c, Direction d, uint32_t distance) const;
+
+public:
+    Direction getDirection() const { return _own.direction(); }
+    int getShellsRemaining() const { return _own.shells(); }
+};
+
+} // namespace Algorithm_212934582_323964676
+
+#endif // EVASIVETANKAI_212934582_323964676_H
@@ -0,0 +1,891 @@
+#include "FiringDistanceField_212934582_323964676.h"
+#include <algorithm>
+#include <functional>
+
+namespace Algorithm_212934582_323964676 {
+
+using UserCommon_212934582_323964676::BoardScan;
+using UserCommon_212934582_323964676::CharSet;
+
+namespace {
+
+// Walls, mines and tanks: a shot stops at the first of them
+const CharSet SHOT_STOPPERS("#@0123456789");
+
+// How many breadth-first expansions one bounded (A*) expansion is worth, and
+// how often the search not in favour is tried again
+constexpr size_t BOUNDED_EXPANSION_COST = 2;
+constexpr uint64_t PROBE_INTERVAL = 16;
+
+// Weight of the bound in the coarse search (weighted A*): routes come out at
+// most this many times the shortest through the entrances, and the search
+// heads for the goals instead of spreading over the whole map
+constexpr uint32_t ROUTE_WEIGHT = 2;
+
+// One cell's share of a board hash: the board hashes to the XOR of those of
+// its non-empty cells (splitmix64 of cell and character)
+uint64_t cellHash(size_t cell, char ch) {
+    if (ch == ' ') {
+        return 0;
+    }
+    uint64_t z = static_cast<uint64_t>(cell) * 256 + static_cast<unsigned char>(ch) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Every tank digit but `playerIndex`'s
+CharSet enemyDigits(int playerIndex) {
+    CharSet enemies;
+    for (char ch = '0'; ch <= '9'; ++ch) {
+        if (ch - '0' != playerIndex) enemies.add(ch);
+    }
+    return enemies;
+}
+
+} // namespace
+
+FiringDistanceField_212934582_323964676::FiringDistanceField_212934582_323964676(int playerIndex)
+    : _playerIndex(playerIndex)
+    , _enemyChars(enemyDigits(playerIndex))
+    , _rows(0)
+    , _cols(0)
+    , _boardHash(0)
+    , _fieldValid(false)
+    , _generation(0)
+    , _lastSearchCost(0)
+    , _searches(0)
+    , _breadthFirstCost(SIZE_MAX)
+    , _boundedSearchCost(0)
+    , _fieldBackoff(0)
+    , _backoffLength(0)
+    , _fieldCost(0)
+    , _fieldSavings(0)
+    , _boundsStale(true)
+    , _boundsFill(0)
+    , _entranceGeneration(0)
+{
+}
+
+void FiringDistanceField_212934582_323964676::update(
+    UserCommon_212934582_323964676::GridSnapshot board,
+    std::shared_ptr<const std::vector<uint8_t>> masks,
+    const std::pmr::vector<UserCommon_212934582_323964676::CellChange>* changes)
+{
+    size_t rows = board->size();
+    size_t cols = rows ? (*board)[0].size() : 0;
+    if (rows != _rows || cols != _cols) {
+        changes = nullptr;  // a different map altogether
+    }
+    _rows  = rows;
+    _cols  = cols;
+
+    // Rehash only the changed cells when there is a list of them
+    if (changes && _board) {
+        _hashCells.clear();
+        for (const auto& change : *changes) {
+            _hashCells.push_back(change.row * static_cast<uint32_t>(cols) + change.col);
+        }
+        std::sort(_hashCells.begin(), _hashCells.end());
+        _hashCells.erase(std::unique(_hashCells.begin(), _hashCells.end()), _hashCells.end());
+        for (uint32_t cell : _hashCells) {
+            _boardHash ^= cellHash(cell, (*_board)[cell / cols][cell % cols]) ^ cellHash(cell, (*board)[cell / cols][cell % cols]);
+        }
+    } else {
+        _boardHash = 0;
+        for (size_t r = 0; r < rows; ++r) {
+            for (size_t c = 0; c < cols; ++c) {
+                _boardHash ^= cellHash(r * cols + c, (*board)[r][c]);
+            }
+        }
+    }
+    _board = std::move(board);
+
+    // The static analysis stays valid until a wall or mine appears or goes
+    bool relayout = !changes || !_analysis;
+    if (!relayout) {
+        for (const auto& change : *changes) {
+            if (_analysis->isStatic(change.row, change.col) != (change.cell == '#' || change.cell == '@')) {
+                relayout = true;
+                break;
+            }
+        }
+    }
+    if (relayout) {
+        _analysis = StaticMapAnalysis_212934582_323964676::forBoard(*_board);
+    }
+
+    if (masks) {
+        _moveMasks = std::move(masks);
+        _ownMasks  = {};
+    } else {
+        if (changes && !_ownMasks.empty()) {
+            for (const auto& change : *changes) {
+                _ownMasks.cellChanged(*_board, change.row, change.col);
+            }
+        } else {
+            _ownMasks.build(*_board, _rows, _cols, /*corner_cut=*/true);
+        }
+        _moveMasks = std::make_shared<const std::vector<uint8_t>>(_ownMasks.masks());
+    }
+
+    // patch the list of enemy coordinates when we know what changed, otherwise
+    // rebuild it from the whole board
+    if (changes) {
+        applyChanges(*changes);
+    } else {
+        findEnemies();
+        _fieldValid = false;  // no idea what changed: the next search starts over
+    }
+
+    // every (cell, facing) an enemy can be shot from, for the goal test
+    buildGoalMap();
+}
+
+ActionRequest FiringDistanceField_212934582_323964676::nextAction(int r, int c, Direction d) {
+    const uint32_t start = static_cast<uint32_t>((r * static_cast<int>(_cols) + c) * 8 + static_cast<int>(d));
+
+    // Bring the field up to date when a repair is cheap (the first tank to ask
+    // after an update pays for it); otherwise search forward from this tank
+    if (!refreshDistanceField()) {
+        return searchForward(start);
+    }
+
+    // Follow the field downhill. Taking the first action, in the order the
+    // forward search expands them, that leads one step closer picks exactly the
+    // move the forward search would make.
+    _fieldSavings += _lastSearchCost;
+    const uint32_t dist = _dist[start];
+    if (dist != UNREACHED) {
+        bool found = false;
+        ActionRequest firstMove = ActionRequest::RotateRight90;
+        forEachSuccessor(start, [&](uint32_t next, ActionRequest action) {
+            if (!found && _dist[next] != UNREACHED && _dist[next] + 1 == dist) {
+                firstMove = action;
+                found = true;
+            }
+        });
+        if (found) {
+            return firstMove;
+        }
+    }
+
+    // no reachable shooting state - spin in place
+    return ActionRequest::RotateRight90;
+}
+
+// A tank on cell X facing d hits enemy E when the first wall, mine or tank on
+// the ray from X in direction d is E. Walking outward from E against d visits
+// exactly those cells X: each one is a goal for facing d, and the walk stops
+// after the first cell that would itself block the ray.
+void FiringDistanceField_212934582_323964676::buildGoalMap() {
+    const int C = static_cast<int>(_cols);
+    const size_t cells = _rows * _cols;
+    if (_goalDirs.size() != cells) {
+        _goalDirs.assign(cells, 0);
+        _prevGoalDirs.assign(cells, 0);
+        _goalCells.clear();
+        _fieldValid = false;
+    }
+
+    // Clear the previous bits, touching only the cells that had any
+    _prevGoalCells.swap(_goalCells);
+    _goalCells.clear();
+    for (uint32_t cell : _prevGoalCells) {
+        _prevGoalDirs[cell] = _goalDirs[cell];
+        _goalDirs[cell] = 0;
+    }
+
+    const auto& board = *_board;
+    _goalBoxes.clear();
+    for (const auto& [er, ec] : _enemyPositions) {
+        GoalBox box{INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+        for (int d = 0; d < 8; ++d) {
+            auto [dr, dc] = DirectionUtils::toVector(static_cast<Direction>(d));
+            size_t steps = BoardScan::rayLength(board, er, ec, -dr, -dc, SHOT_STOPPERS);
+            if (steps > 0) {
+                const int k = static_cast<int>(steps);
+                box.top = std::min({box.top, er - dr, er - k * dr});
+                box.bottom = std::max({box.bottom, er - dr, er - k * dr});
+                box.left = std::min({box.left, ec - dc, ec - k * dc});
+                box.right = std::max({box.right, ec - dc, ec - k * dc});
+            }
+            for (int k = 1; k <= static_cast<int>(steps); ++k) {
+                uint32_t cell = static_cast<uint32_t>((er - k * dr) * C + ec - k * dc);
+                if (_goalDirs[cell] == 0) {
+                    _goalCells.push_back(cell);
+                }
+                _goalDirs[cell] |= static_cast<uint8_t>(1u << d);
+            }
+        }
+        if (box.top <= box.bottom) {
+            _goalBoxes.push_back(box);
+        }
+    }
+
+    // States on cells whose goal bits changed must be rechecked by the next repair
+    for (uint32_t cell : _prevGoalCells) {
+        if (_goalDirs[cell] != _prevGoalDirs[cell]) {
+            markCellDirty(static_cast<int>(cell) / C, static_cast<int>(cell) % C);
+        }
+    }
+    for (uint32_t cell : _goalCells) {
+        if (_prevGoalDirs[cell] == 0) {
+            markCellDirty(static_cast<int>(cell) / C, static_cast<int>(cell) % C);
+        }
+    }
+    for (uint32_t cell : _prevGoalCells) {
+        _prevGoalDirs[cell] = 0;
+    }
+    _boundsStale = true;
+}
+
+// For landmark k every goal cell g gives the bound |dist_k(x) - dist_k(g)| on
+// the steps from x to g, so the steps from x to the nearest goal are at least
+// the distance from dist_k(x) to the nearest dist_k(g): one table per landmark,
+// indexed by dist_k(x), filled with a pass each way.
+void FiringDistanceField_212934582_323964676::fillGoalBounds() {
+    const auto& analysis = *_analysis;
+    _boundsStale = false;
+    _goalComponents.clear();
+    for (uint32_t cell : _goalCells) {
+        uint32_t component = analysis.component(cell);
+        if (component != StaticMapAnalysis_212934582_323964676::NO_COMPONENT) {
+            _goalComponents.push_back(component);
+        }
+    }
+    std::sort(_goalComponents.begin(), _goalComponents.end());
+    _goalComponents.erase(std::unique(_goalComponents.begin(), _goalComponents.end()), _goalComponents.end());
+
+    if (const ClusterGraph_212934582_323964676* graph = analysis.clusters()) {
+        // no landmarks on such a map; the regions stand in for them
+        _goalRegions.clear();
+        for (uint32_t cell : _goalCells) {
+            uint32_t region = graph->region(cell);
+            if (region != ClusterGraph_212934582_323964676::NO_REGION) {
+                _goalRegions.push_back(region);
+            }
+        }
+        std::sort(_goalRegions.begin(), _goalRegions.end());
+        _goalRegions.erase(std::unique(_goalRegions.begin(), _goalRegions.end()), _goalRegions.end());
+        return;
+    }
+
+    if (_cellBounds.size() != _rows * _cols) {
+        _cellBounds.assign(_rows * _cols, 0);
+        _boundsFill = 0;
+    }
+    if (++_boundsFill == 0x10000) {
+        // fill numbers wrapped around: forget every old bound once
+        std::fill(_cellBounds.begin(), _cellBounds.end(), 0);
+        _boundsFill = 1;
+    }
+
+    const size_t landmarks = analysis.landmarkCount();
+    _boundOffsets.resize(landmarks);
+    size_t total = 0;
+    for (size_t k = 0; k < landmarks; ++k) {
+        _boundOffsets[k] = total;
+        total += static_cast<size_t>(analysis.landmarkRange(k)) + 1;
+    }
+    constexpr uint16_t NONE = UINT16_MAX;
+    _goalBounds.assign(total, NONE);
+    for (uint32_t cell : _goalCells) {
+        const uint16_t* dists = analysis.landmarkDistances(cell);
+        for (size_t k = 0; k < landmarks; ++k) {
+            if (dists[k] != StaticMapAnalysis_212934582_323964676::FAR) {
+                _goalBounds[_boundOffsets[k] + dists[k]] = 0;
+            }
+        }
+    }
+    for (size_t k = 0; k < landmarks; ++k) {
+        uint16_t* bounds = &_goalBounds[_boundOffsets[k]];
+        const size_t n = static_cast<size_t>(analysis.landmarkRange(k)) + 1;
+        for (size_t v = 1; v < n; ++v) {
+            if (bounds[v - 1] != NONE) bounds[v] = std::min<uint16_t>(bounds[v], bounds[v - 1] + 1);
+        }
+        for (size_t v = n - 1; v > 0; --v) {
+            if (bounds[v] != NONE) bounds[v - 1] = std::min<uint16_t>(bounds[v - 1], bounds[v] + 1);
+        }
+        if (bounds[0] == NONE) {
+            std::fill(bounds, bounds + n, 0);  // no goal this landmark reaches: it proves nothing
+        }
+    }
+}
+
+template <class Visit>
+void FiringDistanceField_212934582_323964676::forEachSuccessor(uint32_t state, Visit&& visit) const {
+    const int C = static_cast<int>(_cols);
+    const int di = static_cast<int>(state % 8);
+    const int cell = static_cast<int>(state / 8);
+    const int r = cell / C;
+    const int c = cell % C;
+    const Direction d = static_cast<Direction>(di);
+    const uint32_t base = state - static_cast<uint32_t>(di);
+
+    // rotations keep the cell
+    visit(base + static_cast<uint32_t>(DirectionUtils::rotate45cw(d)), ActionRequest::RotateRight45);
+    visit(base + static_cast<uint32_t>(DirectionUtils::rotate45ccw(d)), ActionRequest::RotateLeft45);
+    visit(base + static_cast<uint32_t>(DirectionUtils::rotate90(d, /*cw=*/true)), ActionRequest::RotateRight90);
+    visit(base + static_cast<uint32_t>(DirectionUtils::rotate90(d, /*cw=*/false)), ActionRequest::RotateLeft90);
+
+    // moves keep the facing
+    if (canStep(r, c, d)) {
+        auto [dr, dc] = DirectionUtils::toVector(d);
+        visit(static_cast<uint32_t>(((r + dr) * C + (c + dc)) * 8 + di), ActionRequest::MoveForward);
+    }
+    Direction backDir = DirectionUtils::rotate180(d);
+    if (canStep(r, c, backDir)) {
+        auto [dr, dc] = DirectionUtils::toVector(backDir);
+        visit(static_cast<uint32_t>(((r + dr) * C + (c + dc)) * 8 + di), ActionRequest::MoveBackward);
+    }
+}
+
+template <class Visit>
+void FiringDistanceField_212934582_323964676::forEachPredecessor(uint32_t state, Visit&& visit) const {
+    const int R = static_cast<int>(_rows);
+    const int C = static_cast<int>(_cols);
+    const int di = static_cast<int>(state % 8);
+    const int cell = static_cast<int>(state / 8);
+    const int r = cell / C;
+    const int c = cell % C;
+    const Direction d = static_cast<Direction>(di);
+    const uint32_t base = state - static_cast<uint32_t>(di);
+
+    // the facing each rotation started from
+    visit(base + static_cast<uint32_t>(DirectionUtils::rotate45ccw(d)));
+    visit(base + static_cast<uint32_t>(DirectionUtils::rotate45cw(d)));
+    visit(base + static_cast<uint32_t>(DirectionUtils::rotate90(d, /*cw=*/false)));
+    visit(base + static_cast<uint32_t>(DirectionUtils::rotate90(d, /*cw=*/true)));
+
+    // MoveForward from one cell behind, MoveBackward from one cell ahead
+    auto [dr, dc] = DirectionUtils::toVector(d);
+    int br = r - dr, bc = c - dc;
+    if (br >= 0 && bc >= 0 && br < R && bc < C && canStep(br, bc, d)) {
+        visit(static_cast<uint32_t>((br * C + bc) * 8 + di));
+    }
+    int ar = r + dr, ac = c + dc;
+    if (ar >= 0 && ac >= 0 && ar < R && ac < C && canStep(ar, ac, DirectionUtils::rotate180(d))) {
+        visit(static_cast<uint32_t>((ar * C + ac) * 8 + di));
+    }
+}
+
+void FiringDistanceField_212934582_323964676::markCellDirty(int r, int c) {
+    if (!_fieldValid) {
+        return;  // the field is rebuilt anyway
+    }
+    uint32_t base = static_cast<uint32_t>((r * static_cast<int>(_cols) + c) * 8);
+    for (uint32_t d = 0; d < 8; ++d) {
+        _dirtyStates.push_back(base + d);
+    }
+}
+
+// Repairs may take at most twice what the last forward search cost. A repair
+// that runs over leaves the field to be rebuilt after a backoff. The backoff
+// shrinks when the field saved more search work than it cost since its last
+// rebuild, and grows when it did not (with teammates sharing the field, a
+// rebuild pays off only if enough of their turns use it before the next
+// failure).
+bool FiringDistanceField_212934582_323964676::refreshDistanceField() {
+    if (_analysis->clusters()) {
+        // too large a map for a field over every state; searchHierarchical()
+        // routes each tank instead
+        _dirtyStates.clear();
+        _fieldValid = false;
+        return false;
+    }
+    const size_t states = _rows * _cols * 8;
+    if (_fieldValid && _dist.size() == states) {
+        size_t budget = std::max<size_t>(_lastSearchCost ? 2 * _lastSearchCost : states / 4, 1024);
+        bool repaired = repairDistanceField(budget);
+        _dirtyStates.clear();
+        if (repaired) {
+            return true;
+        }
+        _fieldValid = false;
+        if (_fieldSavings > _fieldCost) {
+            _backoffLength /= 2;
+        } else {
+            _backoffLength = std::min(std::max(2 * _backoffLength, 1), 64);
+        }
+        _fieldBackoff = _backoffLength;
+        return false;
+    }
+    _dirtyStates.clear();
+    if (_fieldBackoff > 0) {
+        --_fieldBackoff;
+        return false;
+    }
+    rebuildDistanceField();
+    return true;
+}
+
+// Both searches find the same first action, so either will do; the cheaper
+// one is used. A* with goalBound() expands fewer states, but each costs about
+// twice as much, and where the bound stays well below the true distance (long
+// corridors) it expands nearly as many. Every PROBE_INTERVAL-th search runs
+// the other one, to compare what each cost on this map last time.
+ActionRequest FiringDistanceField_212934582_323964676::searchForward(uint32_t start) {
+    if (_boundsStale) {
+        fillGoalBounds();
+    }
+
+    // Tanks only block more: without a goal in the start's static component,
+    // no firing state can be reached
+    const uint32_t component = _analysis->component(start / 8);
+    if (component != StaticMapAnalysis_212934582_323964676::NO_COMPONENT &&
+        !std::binary_search(_goalComponents.begin(), _goalComponents.end(), component)) {
+        _lastSearchCost = 1;
+        return ActionRequest::RotateRight90;
+    }
+    if (canShootFrom(static_cast<int>(start / 8) / static_cast<int>(_cols),
+                     static_cast<int>(start / 8) % static_cast<int>(_cols),
+                     static_cast<Direction>(start % 8))) {
+        _lastSearchCost = 1;
+        return ActionRequest::RotateRight90;  // nothing to move for
+    }
+    if (_analysis->clusters()) {
+        return searchHierarchical(start);
+    }
+
+    const size_t states = _rows * _cols * 8;
+    if (_marks.size() != states) {
+        _marks.assign(states, {0, 0});
+        _queue.reset(states);
+        _generation = 0;
+    }
+    _generation += 2;
+    if (_generation < 2) {
+        // stamps wrapped around: forget every old search once
+        std::fill(_marks.begin(), _marks.end(), SearchMark{0, 0});
+        _generation = 2;
+    }
+    bool bounded = BOUNDED_EXPANSION_COST * _boundedSearchCost < _breadthFirstCost;
+    if (++_searches % PROBE_INTERVAL == 0) {
+        bounded = !bounded;
+    }
+    ActionRequest action = bounded ? searchBounded(start) : searchBreadthFirst(start);
+    (bounded ? _boundedSearchCost : _breadthFirstCost) = _lastSearchCost;
+    return action;
+}
+
+ActionRequest FiringDistanceField_212934582_323964676::searchBreadthFirst(uint32_t start) {
+    const uint32_t reached = _generation;
+    ActionRequest firstActions[RANKS] = {};
+    uint32_t ranks = 0;
+    _queue.clear();
+    _marks[start].stamp = reached;
+    forEachSuccessor(start, [&](uint32_t next, ActionRequest action) {
+        firstActions[ranks] = action;
+        _marks[next] = {reached, 8 + ranks++};
+        _queue.push(next);
+    });
+    size_t expanded = 1;
+    while (!_queue.empty()) {
+        uint32_t state = _queue.pop();
+        ++expanded;
+        const uint32_t path = _marks[state].path;
+        if (canShootFrom(static_cast<int>(state / 8) / static_cast<int>(_cols),
+                         static_cast<int>(state / 8) % static_cast<int>(_cols),
+                         static_cast<Direction>(state % 8))) {
+            _lastSearchCost = expanded;
+            return firstActions[path % 8];
+        }
+        forEachSuccessor(state, [&](uint32_t next, ActionRequest) {
+            if (_marks[next].stamp != reached) {
+                _marks[next] = {reached, path + 8};
+                _queue.push(next);
+            }
+        });
+    }
+    _lastSearchCost = expanded;
+    return ActionRequest::RotateRight90;  // no reachable shooting state - spin in place
+}
+
+// Breadth-first search takes, of all the shortest paths, the one whose first
+// action comes earliest in successor order (its rank). A* finds the same one
+// when a state's path is ordered by (actions, rank) and the queue by
+// (actions + goalBound, rank): with a consistent bound, keys only grow along a
+// path, so the buckets are taken in order and a state's first entry to come
+// out has its best path. Later entries of an expanded state are skipped.
+ActionRequest FiringDistanceField_212934582_323964676::searchBounded(uint32_t start) {
+    const uint32_t reached = _generation;
+    const uint32_t expandedStamp = _generation + 1;
+
+    // A successor's key is at most 2 * RANKS + RANKS - 1 above its state's (one
+    // more action, a bound one higher, and any rank after the start), so the
+    // keys queued at any time fit a ring of OPEN_RING buckets
+    constexpr size_t OPEN_RING = 32;
+    static_assert(3 * RANKS <= OPEN_RING, "queued keys must not wrap around");
+    if (_open.size() != OPEN_RING) {
+        _open.assign(OPEN_RING, {});
+    }
+    const uint32_t startCell = start / 8;
+    const size_t firstKey = static_cast<size_t>(goalBound(startCell)) * RANKS;
+    size_t lastKey = firstKey;
+    auto reach = [&](uint32_t state, uint32_t dist, uint32_t rank, uint32_t bound) {
+        const uint32_t path = dist * 8 + rank;
+        SearchMark& mark = _marks[state];
+        if (mark.stamp == expandedStamp || (mark.stamp == reached && mark.path <= path)) {
+            return;  // an expanded state already has a path at least this good
+        }
+        mark = {reached, path};
+        const size_t key = static_cast<size_t>(dist + bound) * RANKS + rank;
+        _open[key % OPEN_RING].push_back(state);
+        lastKey = std::max(lastKey, key);
+    };
+    auto boundOf = [&](uint32_t state, uint32_t cell, uint32_t bound) {
+        return state / 8 == cell ? bound : goalBound(state / 8);
+    };
+
+    // The start's successors, each the first action of its paths
+    _marks[start].stamp = expandedStamp;
+    ActionRequest firstActions[RANKS] = {};
+    uint32_t ranks = 0;
+    forEachSuccessor(start, [&](uint32_t next, ActionRequest action) {
+        firstActions[ranks] = action;
+        reach(next, 1, ranks++, boundOf(next, startCell, static_cast<uint32_t>(firstKey / RANKS)));
+    });
+
+    size_t expanded = 1;
+    bool found = false;
+    ActionRequest result = ActionRequest::RotateRight90;  // no reachable shooting state - spin in place
+    for (size_t key = firstKey; key <= lastKey && !found; ++key) {
+        std::vector<uint32_t>& bucket = _open[key % OPEN_RING];
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            const uint32_t state = bucket[i];
+            SearchMark& mark = _marks[state];
+            if (mark.stamp == expandedStamp) {
+                continue;
+            }
+            mark.stamp = expandedStamp;
+            ++expanded;
+            const uint32_t cell = state / 8;
+            const uint32_t dist = mark.path / 8;
+            const uint32_t rank = mark.path % 8;
+            if (canShootFrom(static_cast<int>(cell) / static_cast<int>(_cols),
+                             static_cast<int>(cell) % static_cast<int>(_cols),
+                             static_cast<Direction>(state % 8))) {
+                result = firstActions[rank];
+                found = true;
+                break;
+            }
+            const uint32_t bound = static_cast<uint32_t>(key / RANKS) - dist;
+            forEachSuccessor(state, [&](uint32_t next, ActionRequest) {
+                reach(next, dist + 1, rank, boundOf(next, cell, bound));
+            });
+        }
+        if (!found) {
+            bucket.clear();
+        }
+    }
+    for (auto& bucket : _open) {
+        bucket.clear();
+    }
+    _lastSearchCost = expanded;
+    return result;
+}
+
+// The fine search covers the window of the start's cluster and the clusters
+// around it, breadth-first as searchBreadthFirst() does; a firing state in it
+// ends the search there. Otherwise the window's entrances, with the actions the
+// fine search took to reach them, start a weighted A* over the ClusterGraph,
+// which stops at the first entrance to a region with a goal cell and returns
+// the first action of the route to it. Tanks are seen only in
+// the window; the route beyond follows the walls and mines alone.
+ActionRequest FiringDistanceField_212934582_323964676::searchHierarchical(uint32_t start) {
+    const ClusterGraph_212934582_323964676& graph = *_analysis->clusters();
+    constexpr size_t S = ClusterGraph_212934582_323964676::CLUSTER_SIZE;
+    const size_t startRow = start / 8 / _cols;
+    const size_t startCol = start / 8 % _cols;
+    const size_t clusterRow = startRow / S;
+    const size_t clusterCol = startCol / S;
+    const size_t firstClusterRow = clusterRow > 0 ? clusterRow - 1 : 0;
+    const size_t firstClusterCol = clusterCol > 0 ? clusterCol - 1 : 0;
+    const size_t lastClusterRow = std::min(clusterRow + 1, graph.clusterRows() - 1);
+    const size_t lastClusterCol = std::min(clusterCol + 1, graph.clusterCols() - 1);
+    const size_t r0 = firstClusterRow * S;
+    const size_t c0 = firstClusterCol * S;
+    const size_t r1 = std::min(_rows, (lastClusterRow + 1) * S);
+    const size_t c1 = std::min(_cols, (lastClusterCol + 1) * S);
+    const size_t width = c1 - c0;
+    auto windowIndex = [&](uint32_t state) -> int64_t {
+        const size_t r = state / 8 / _cols;
+        const size_t c = state / 8 % _cols;
+        if (r < r0 || r >= r1 || c < c0 || c >= c1) return -1;
+        return static_cast<int64_t>(((r - r0) * width + c - c0) * 8 + state % 8);
+    };
+
+    // Fine search: paths are actions * 8 + rank, as in searchBreadthFirst()
+    _windowPaths.assign((r1 - r0) * width * 8, UNREACHED);
+    _windowQueue.clear();
+    ActionRequest firstActions[RANKS] = {};
+    uint32_t ranks = 0;
+    _windowPaths[windowIndex(start)] = 0;
+    forEachSuccessor(start, [&](uint32_t next, ActionRequest action) {
+        firstActions[ranks] = action;
+        const int64_t index = windowIndex(next);
+        if (index >= 0) {
+            _windowPaths[index] = 8 + ranks;
+            _windowQueue.push_back(next);
+        }
+        ++ranks;
+    });
+    size_t expanded = 1;
+    for (size_t i = 0; i < _windowQueue.size(); ++i) {
+        const uint32_t state = _windowQueue[i];
+        ++expanded;
+        const uint32_t path = _windowPaths[windowIndex(state)];
+        if (canShootFrom(static_cast<int>(state / 8) / static_cast<int>(_cols),
+                         static_cast<int>(state / 8) % static_cast<int>(_cols),
+                         static_cast<Direction>(state % 8))) {
+            _lastSearchCost = expanded;
+            return firstActions[path % 8];
+        }
+        forEachSuccessor(state, [&](uint32_t next, ActionRequest) {
+            const int64_t index = windowIndex(next);
+            if (index >= 0 && _windowPaths[index] == UNREACHED) {
+                _windowPaths[index] = path + 8;
+                _windowQueue.push_back(next);
+            }
+        });
+    }
+
+    // Coarse search from the window's entrances, on the best path the fine
+    // search found to any facing of each. A*: an action moves a tank at most
+    // one cell either way, so the rows or columns between a cell and the
+    // nearest goal box bound the actions left; the bound counts ROUTE_WEIGHT
+    // times.
+    auto estimate = [&](uint32_t cell) {
+        const int r = static_cast<int>(cell / _cols);
+        const int c = static_cast<int>(cell % _cols);
+        int best = INT_MAX;
+        for (const GoalBox& box : _goalBoxes) {
+            const int dr = std::max({box.top - r, r - box.bottom, 0});
+            const int dc = std::max({box.left - c, c - box.right, 0});
+            best = std::min(best, std::max(dr, dc));
+        }
+        return best == INT_MAX ? 0u : static_cast<uint32_t>(best);
+    };
+    if (_entranceMarks.size() != graph.entranceCount()) {
+        _entranceMarks.assign(graph.entranceCount(), {0, 0});
+        _entranceGeneration = 0;
+    }
+    _entranceGeneration += 2;
+    if (_entranceGeneration < 2) {
+        std::fill(_entranceMarks.begin(), _entranceMarks.end(), SearchMark{0, 0});
+        _entranceGeneration = 2;
+    }
+    const uint32_t reached = _entranceGeneration;
+    const uint32_t expandedStamp = _entranceGeneration + 1;
+    _entranceHeap.clear();
+    auto reach = [&](uint32_t entrance, uint32_t path) {
+        SearchMark& mark = _entranceMarks[entrance];
+        if (mark.stamp == expandedStamp || (mark.stamp == reached && mark.path <= path)) {
+            return;  // weighted, a first expansion is final even if not the best
+        }
+        mark = {reached, path};
+        _entranceHeap.emplace_back(path + ROUTE_WEIGHT * estimate(graph.entranceCell(entrance)) * 8, path, entrance);
+        std::push_heap(_entranceHeap.begin(), _entranceHeap.end(), std::greater<>());
+    };
+    for (size_t cr = firstClusterRow; cr <= lastClusterRow; ++cr) {
+        for (size_t cc = firstClusterCol; cc <= lastClusterCol; ++cc) {
+            const size_t cluster = cr * graph.clusterCols() + cc;
+            for (uint32_t e = graph.firstEntrance(cluster); e < graph.firstEntrance(cluster + 1); ++e) {
+                const int64_t index = windowIndex(graph.entranceCell(e) * 8);
+                const uint32_t* paths = &_windowPaths[index];
+                const uint32_t best = *std::min_element(paths, paths + 8);
+                if (best != UNREACHED && best >= 8) {
+                    reach(e, best);
+                }
+            }
+        }
+    }
+    ActionRequest result = ActionRequest::RotateRight90;  // no reachable shooting state - spin in place
+    while (!_entranceHeap.empty()) {
+        std::pop_heap(_entranceHeap.begin(), _entranceHeap.end(), std::greater<>());
+        const auto [key, path, entrance] = _entranceHeap.back();
+        _entranceHeap.pop_back();
+        SearchMark& mark = _entranceMarks[entrance];
+        if (mark.stamp == expandedStamp || mark.path != path) {
+            continue;
+        }
+        mark.stamp = expandedStamp;
+        ++expanded;
+        if (std::binary_search(_goalRegions.begin(), _goalRegions.end(), graph.region(graph.entranceCell(entrance)))) {
+            result = firstActions[path % 8];
+            break;
+        }
+        for (const auto* link = graph.linksBegin(entrance); link != graph.linksEnd(entrance); ++link) {
+            reach(link->to, path + link->cost * 8);
+        }
+    }
+    _lastSearchCost = expanded;
+    return result;
+}
+
+// Multi-source BFS backwards from every firing state
+void FiringDistanceField_212934582_323964676::rebuildDistanceField() {
+    const size_t states = _rows * _cols * 8;
+    if (_dist.size() != states) {
+        _queue.reset(states);
+    }
+    _dist.assign(states, UNREACHED);
+    _queue.clear();
+    for (uint32_t cell : _goalCells) {
+        for (uint32_t d = 0; d < 8; ++d) {
+            if ((_goalDirs[cell] >> d) & 1u) {
+                _dist[cell * 8 + d] = 0;
+                _queue.push(cell * 8 + d);
+            }
+        }
+    }
+    size_t expanded = 0;
+    while (!_queue.empty()) {
+        uint32_t state = _queue.pop();
+        ++expanded;
+        uint32_t next = _dist[state] + 1;
+        forEachPredecessor(state, [&](uint32_t prev) {
+            if (_dist[prev] == UNREACHED) {
+                _dist[prev] = next;
+                _queue.push(prev);
+            }
+        });
+    }
+    _fieldValid   = true;
+    _fieldCost    = expanded;
+    _fieldSavings = 0;
+}
+
+// Incremental repair for unit-cost edges, in the spirit of LPA*/D* Lite.
+// Phase 1 drops every state that lost its last neighbour one step closer to a
+// goal (and, transitively, states that relied on it). Phase 2 recomputes those
+// and the dirty states from their successors and spreads any improvement
+// backwards with a bucket queue. Work is proportional to the affected area;
+// returns false, leaving the field unusable, if it exceeds `budget` states.
+bool FiringDistanceField_212934582_323964676::repairDistanceField(size_t budget) {
+    auto isGoal = [this](uint32_t state) { return (_goalDirs[state / 8] >> (state % 8)) & 1u; };
+
+    size_t work = 0;
+
+    // Phase 1: invalidate unsupported states
+    _work.assign(_dirtyStates.begin(), _dirtyStates.end());
+    for (size_t i = 0; i < _work.size(); ++i) {
+        if (++work > budget) {
+            return false;
+        }
+        uint32_t state = _work[i];
+        uint32_t dist = _dist[state];
+        if (dist == UNREACHED || isGoal(state)) {
+            continue;
+        }
+        bool supported = false;
+        forEachSuccessor(state, [&](uint32_t next, ActionRequest) {
+            supported = supported || (_dist[next] != UNREACHED && _dist[next] + 1 == dist);
+        });
+        if (supported) {
+            continue;
+        }
+        _dist[state] = UNREACHED;
+        forEachPredecessor(state, [&](uint32_t prev) {
+            if (_dist[prev] == dist + 1) {
+                _work.push_back(prev);  // may have relied on state
+            }
+        });
+    }
+
+    // Phase 2: re-evaluate, then propagate decreases in distance order
+    size_t pending = 0;
+    size_t lowest = SIZE_MAX;
+    auto push = [&](uint32_t state, uint32_t dist) {
+        if (_buckets.size() <= dist) {
+            _buckets.resize(dist + 1);
+        }
+        _buckets[dist].push_back(state);
+        ++pending;
+        lowest = std::min<size_t>(lowest, dist);
+    };
+    // Giving up must not leave queued states behind for the next repair
+    auto abandon = [this]() {
+        for (auto& bucket : _buckets) {
+            bucket.clear();
+        }
+        return false;
+    };
+    for (uint32_t state : _work) {
+        if (++work > budget) {
+            return abandon();
+        }
+        uint32_t best = UNREACHED;
+        if (isGoal(state)) {
+            best = 0;
+        } else {
+            forEachSuccessor(state, [&](uint32_t next, ActionRequest) {
+                if (_dist[next] != UNREACHED) {
+                    best = std::min(best, _dist[next] + 1);
+                }
+            });
+        }
+        if (best < _dist[state]) {
+            _dist[state] = best;
+            push(state, best);
+        }
+    }
+    for (size_t b = lowest; pending > 0; ++b) {
+        for (size_t i = 0; i < _buckets[b].size(); ++i) {
+            if (++work > budget) {
+                return abandon();
+            }
+            uint32_t state = _buckets[b][i];
+            --pending;
+            if (_dist[state] != b) {
+                continue;  // improved again after it was queued
+            }
+            uint32_t next = static_cast<uint32_t>(b + 1);
+            forEachPredecessor(state, [&](uint32_t prev) {
+                if (_dist[prev] == UNREACHED || _dist[prev] > next) {
+                    _dist[prev] = next;
+                    push(prev, next);
+                }
+            });
+        }
+        _buckets[b].clear();
+    }
+    _fieldCost += work;
+    return true;
+}
+
+void FiringDistanceField_212934582_323964676::findEnemies() {
+    _enemyPositions.clear();
+
+    const auto& board = *_board;
+    for (int r = 0; r < static_cast<int>(std::min(_rows, board.size())); ++r) {
+        const std::string& line = board[r];
+        BoardScan::forEach(line.data(), std::min(_cols, line.size()), _enemyChars, [&](size_t c) {
+            _enemyPositions.emplace_back(r, static_cast<int>(c));
+        });
+    }
+}
+
+void FiringDistanceField_212934582_323964676::applyChanges(
+    const std::pmr::vector<UserCommon_212934582_323964676::CellChange>& changes) {
+    for (const auto& change : changes) {
+        int r = static_cast<int>(change.row);
+        int c = static_cast<int>(change.col);
+        auto it = std::find(_enemyPositions.begin(), _enemyPositions.end(), std::make_pair(r, c));
+        if (it != _enemyPositions.end()) {
+            _enemyPositions.erase(it);
+        }
+        if (_enemyChars.contains(change.cell)) {
+            _enemyPositions.emplace_back(r, c);
+        }
+        // moves out of any cell in the 3x3 block around (r,c) may have changed
+        for (int nr = std::max(r - 1, 0); nr <= std::min(r + 1, static_cast<int>(_rows) - 1); ++nr) {
+            for (int nc = std::max(c - 1, 0); nc <= std::min(c + 1, static_cast<int>(_cols) - 1); ++nc) {
+                markCellDirty(nr, nc);
+            }
+        }
+    }
+}
+
+} // namespace Algorithm_212934582_323964676
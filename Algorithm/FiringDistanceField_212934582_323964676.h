@@ -0,0 +1,232 @@
+#ifndef FIRINGDISTANCEFIELD_212934582_323964676_H
+#define FIRINGDISTANCEFIELD_212934582_323964676_H
+
+#include "../common/ActionRequest.h"
+#include "../UserCommon/Utils_212934582_323964676.h"  // For Direction and DirectionUtils
+#include "../UserCommon/SharedGrid_212934582_323964676.h"
+#include "../UserCommon/ChangeJournal_212934582_323964676.h"
+#include "../UserCommon/MoveMask_212934582_323964676.h"
+#include "../UserCommon/MyBattleInfo_212934582_323964676.h"
+#include "../UserCommon/BoardScan_212934582_323964676.h"
+#include "StaticMapAnalysis_212934582_323964676.h"
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <memory_resource>
+#include <utility>
+#include <tuple>
+#include <cstdint>
+#include <climits>
+
+namespace Algorithm_212934582_323964676 {
+
+using UserCommon_212934582_323964676::Direction;
+using UserCommon_212934582_323964676::DirectionUtils;
+
+// Fewest actions from every (cell, facing) to a state that can shoot an enemy of
+// one player, kept across turns and shared by all of that player's tanks: the
+// enemies and the board are the same for each of them, so one field answers
+// every tank. Between updates it is repaired only around the cells that changed.
+// A map with a ClusterGraph is too large for a field: each tank is routed by a
+// hierarchical search instead.
+// Not thread-safe; a field belongs to one player in one game.
+class FiringDistanceField_212934582_323964676 {
+public:
+    explicit FiringDistanceField_212934582_323964676(int playerIndex);
+
+    // Move the field to a new board. `changes` lists every cell that differs from
+    // the board of the previous update, or is null when that is unknown (the
+    // field is then rebuilt). `masks` are the board's MoveMaskGrid masks with
+    // corner-cut checking; when null the field keeps its own.
+    void update(UserCommon_212934582_323964676::GridSnapshot board,
+                std::shared_ptr<const std::vector<uint8_t>> masks,
+                const std::pmr::vector<UserCommon_212934582_323964676::CellChange>* changes);
+
+    const UserCommon_212934582_323964676::GridSnapshot& board() const { return _board; }
+    // A 64-bit hash of board(), kept up to date from the changes
+    uint64_t boardHash() const { return _boardHash; }
+
+    // Return true if a tank on (r,c) facing d would hit an enemy (walls and mines
+    // block the shot, so does any tank in between). A single _goalDirs lookup.
+    bool canShootFrom(int r, int c, Direction d) const {
+        return (_goalDirs[static_cast<size_t>(r) * _cols + c] >> static_cast<int>(d)) & 1u;
+    }
+
+    // First action on a shortest path from (r,c) facing d to a firing state,
+    // RotateRight90 when there is none. (r,c) must be on the board.
+    ActionRequest nextAction(int r, int c, Direction d);
+
+private:
+    // tests/FiringDistanceFieldTest.cpp checks the repair and the searches against each other
+    friend class FiringDistanceFieldTest;
+
+    // Fixed-capacity FIFO of packed search states; never allocates after reset()
+    class StateQueue {
+    public:
+        void reset(size_t capacity) { _ring.assign(capacity, 0); _head = _size = 0; }
+        bool empty() const { return _size == 0; }
+        void clear() { _head = _size = 0; }
+        void push(uint32_t state) {
+            _ring[(_head + _size) % _ring.size()] = state;
+            ++_size;
+        }
+        uint32_t pop() {
+            uint32_t state = _ring[_head];
+            _head = (_head + 1) % _ring.size();
+            --_size;
+            return state;
+        }
+    private:
+        std::vector<uint32_t> _ring;
+        size_t _head = 0;
+        size_t _size = 0;
+    };
+
+    int                            _playerIndex;      // whose enemies the goals are
+    UserCommon_212934582_323964676::CharSet _enemyChars;  // the tank digits of those enemies
+    size_t                         _rows, _cols;      // map dimensions
+    UserCommon_212934582_323964676::GridSnapshot _board;  // board of the last update (shared, read-only)
+    uint64_t                       _boardHash;        // boardHash()
+    std::vector<uint32_t>          _hashCells;        // update scratch: the changed cells, once each
+    std::shared_ptr<const std::vector<uint8_t>> _moveMasks;  // per-cell legal-move bits
+    UserCommon_212934582_323964676::MoveMaskGrid _ownMasks;  // built here when update() gets none
+    std::vector<std::pair<int,int>> _enemyPositions;   // coordinates of all alive enemies
+
+    // Distance field over packed states ((r * cols) + c) * 8 + direction:
+    // _dist[s] is the fewest actions from s to a firing state.
+    static constexpr uint32_t UNREACHED = UINT32_MAX;
+    std::vector<uint32_t>          _dist;             // distance to the nearest firing state
+    bool                           _fieldValid;       // whether _dist is repairable (else rebuilt)
+    std::vector<uint32_t>          _dirtyStates;      // states whose edges or goal status changed since the last repair
+    std::vector<uint32_t>          _work;             // repair scratch: states to recheck
+    std::vector<std::vector<uint32_t>> _buckets;      // repair scratch: bucket queue by distance
+    StateQueue                     _queue;            // BFS frontier (rebuild or forward search); each state enters at most once
+
+    // Forward search from a tank, used while the field costs more to maintain
+    // than it saves (e.g. enemies on the move keep shifting every goal), and
+    // always on a map too large for a field
+    // Paths are ranked by their first action: the position of its successor of
+    // the start, in the order forEachSuccessor() visits them
+    static constexpr uint32_t RANKS = 6;
+    struct SearchMark {
+        uint32_t stamp;  // generation that last reached the state; one more once A* expanded it
+        uint32_t path;   // actions from the start * 8 + rank
+    };
+    std::vector<SearchMark>        _marks;            // per state, one read for both
+    std::vector<std::vector<uint32_t>> _open;         // A* bucket queue by (actions + goalBound) * RANKS + rank, a ring
+    uint32_t                       _generation;       // id of the current forward search (two stamps each)
+    size_t                         _lastSearchCost;   // states the last forward search expanded
+    uint64_t                       _searches;         // forward searches so far
+    size_t                         _breadthFirstCost; // states the last breadth-first search expanded
+    size_t                         _boundedSearchCost;  // states the last A* search expanded
+    int                            _fieldBackoff;     // turns left before the field is rebuilt
+    int                            _backoffLength;    // backoff after the next failed repair
+    size_t                         _fieldCost;        // states the field has cost since its last rebuild
+    size_t                         _fieldSavings;     // forward-search states its answers saved since then
+
+    std::vector<uint8_t>           _goalDirs;         // per cell: bit d set if facing d from it hits an enemy
+    std::vector<uint8_t>           _prevGoalDirs;     // _goalDirs as of the previous update
+    std::vector<uint32_t>          _goalCells;        // cells with any bit set in _goalDirs
+    std::vector<uint32_t>          _prevGoalCells;    // _goalCells as of the previous update
+    struct GoalBox {
+        int top, left, bottom, right;
+    };
+    std::vector<GoalBox>           _goalBoxes;        // per enemy, the rows and columns its goal cells span
+
+    // The walls and mines of _board, analysed once for every game on the map,
+    // and what they bound about the current goals
+    std::shared_ptr<const StaticMapAnalysis_212934582_323964676> _analysis;
+    bool                           _boundsStale;      // goals changed since the two below were filled
+    std::vector<uint32_t>          _goalComponents;   // static components with a goal cell, sorted
+    std::vector<uint16_t>          _goalBounds;       // per landmark k, from _boundOffsets[k]: for each landmark distance v, how far v is from that of the nearest goal cell
+    std::vector<size_t>            _boundOffsets;
+    std::vector<uint32_t>          _cellBounds;       // per cell: goalBound in the low 16 bits, from the fill numbered in the high 16
+    uint32_t                       _boundsFill;       // number of the current fill, from 1
+
+    // Routing on a map with a ClusterGraph (searchHierarchical)
+    std::vector<uint32_t>          _goalRegions;      // regions with a goal cell, sorted (filled with the bounds)
+    std::vector<uint32_t>          _windowPaths;      // per state of the window: actions * 8 + rank, or UNREACHED
+    std::vector<uint32_t>          _windowQueue;      // fine search frontier, by position
+    std::vector<SearchMark>        _entranceMarks;    // per entrance, as _marks is per state
+    std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> _entranceHeap;  // (path + estimate * 8, path, entrance), least first
+    uint32_t                       _entranceGeneration;
+
+    // Queue the 8 states of cell (r,c) for the next repair
+    void markCellDirty(int r, int c);
+
+    // Bring _dist up to date if that is cheap: the incremental repair of
+    // _dirtyStates (nothing once a teammate has repaired for this board), or a
+    // rebuild once the backoff has run out. Returns false when the caller should
+    // search forward instead.
+    bool refreshDistanceField();
+    void rebuildDistanceField();
+    bool repairDistanceField(size_t budget);
+
+    // Search from `start` to the nearest firing state; returns the first action
+    // of the path a breadth-first search would take, from a breadth-first search
+    // or from A* with goalBound(), whichever has been cheaper.
+    ActionRequest searchForward(uint32_t start);
+    ActionRequest searchBreadthFirst(uint32_t start);
+    ActionRequest searchBounded(uint32_t start);
+    // Coarse to fine, on a map with a ClusterGraph: the path it returns the
+    // first action of is short, not always the shortest
+    ActionRequest searchHierarchical(uint32_t start);
+
+    // Fill _goalComponents and _goalBounds (or _goalRegions) for the current
+    // goal cells
+    void fillGoalBounds();
+
+    // Fewest steps from `cell` to any goal cell the landmarks can prove
+    // (admissible and consistent), or 0. Worked out once per cell and fill.
+    uint32_t goalBound(uint32_t cell) {
+        uint32_t cached = _cellBounds[cell];
+        if ((cached >> 16) == _boundsFill) {
+            return cached & 0xFFFFu;
+        }
+        uint32_t bound = 0;
+        const uint16_t* dists = _analysis->landmarkDistances(cell);
+        for (size_t k = 0; k < _boundOffsets.size(); ++k) {
+            uint16_t dist = dists[k];
+            if (dist != StaticMapAnalysis_212934582_323964676::FAR) {
+                bound = std::max<uint32_t>(bound, _goalBounds[_boundOffsets[k] + dist]);
+            }
+        }
+        _cellBounds[cell] = (_boundsFill << 16) | bound;
+        return bound;
+    }
+
+    // Call visit(next, action) for each state one action away from `state`, in the
+    // order the search prefers actions.
+    template <class Visit> void forEachSuccessor(uint32_t state, Visit&& visit) const;
+
+    // Call visit(prev) for each state one action before `state`.
+    template <class Visit> void forEachPredecessor(uint32_t state, Visit&& visit) const;
+
+    // Scan _board to populate _enemyPositions.
+    void findEnemies();
+
+    // Update _enemyPositions and the dirty states from a list of changed cells.
+    void applyChanges(const std::pmr::vector<UserCommon_212934582_323964676::CellChange>& changes);
+
+    // Rebuild _goalDirs by casting rays backwards from every enemy, marking the
+    // cells whose bits changed dirty.
+    void buildGoalMap();
+
+    // Return true if a tank on (r,c) may step one cell in direction d (bounds,
+    // obstacles and the diagonal corner-cut rule). A single mask lookup.
+    bool canStep(int r, int c, Direction d) const {
+        return ((*_moveMasks)[static_cast<size_t>(r) * _cols + c] >> static_cast<int>(d)) & 1u;
+    }
+};
+
+// The battle info Player_Aggressive sends: MyBattleInfo plus the player's field,
+// already updated to `board`
+struct FieldBattleInfo_212934582_323964676 : public UserCommon_212934582_323964676::MyBattleInfo {
+    using MyBattleInfo::MyBattleInfo;
+
+    std::shared_ptr<FiringDistanceField_212934582_323964676> field;
+};
+
+} // namespace Algorithm_212934582_323964676
+
+#endif // FIRINGDISTANCEFIELD_212934582_323964676_H
@@ -0,0 +1,140 @@
+#include "LookaheadRules_212934582_323964676.h"
+#include "../UserCommon/BoardScan_212934582_323964676.h"
+#include <algorithm>
+
+namespace Algorithm_212934582_323964676 {
+
+using UserCommon_212934582_323964676::BoardScan;
+using UserCommon_212934582_323964676::CharSet;
+
+namespace {
+
+// The only cells that are not empty ground to the rules
+const CharSet OCCUPIED("#@12");
+
+} // namespace
+
+void LookaheadRules_212934582_323964676::load(const UserCommon_212934582_323964676::Grid& board) {
+    _rows = board.size();
+    _cols = _rows ? board[0].size() : 0;
+    _terrain.assign(_rows * _cols, ' ');
+    _occupant.assign(_rows * _cols, -1);
+    _tanks.clear();
+    for (size_t r = 0; r < _rows; ++r) {
+        const std::string& line = board[r];
+        BoardScan::forEach(line.data(), std::min(_cols, line.size()), OCCUPIED, [&](size_t c) {
+            char ch = line[c];
+            size_t i = r * _cols + c;
+            if (ch == '#' || ch == '@') {
+                _terrain[i] = ch;
+            } else {
+                _occupant[i] = static_cast<int16_t>(_tanks.size());
+                _tanks.push_back({ static_cast<int>(r), static_cast<int>(c), UNKNOWN_FACING, 0, ch - '0', true });
+            }
+        });
+    }
+}
+
+int LookaheadRules_212934582_323964676::shotVictim(int r, int c, Direction d, int player) const {
+    auto [dr, dc] = DirectionUtils::toVector(d);
+    for (r += dr, c += dc; inside(r, c); r += dr, c += dc) {
+        size_t i = static_cast<size_t>(r) * _cols + c;
+        if (_terrain[i] != ' ') {
+            return -1;
+        }
+        int t = _occupant[i];
+        if (t >= 0) {
+            return _tanks[t].player != player ? t : -1;
+        }
+    }
+    return -1;
+}
+
+bool LookaheadRules_212934582_323964676::isLegal(int t, ActionRequest action) const {
+    const Tank& tank = _tanks[t];
+    if (!tank.alive) {
+        return false;
+    }
+    switch (action) {
+        case ActionRequest::RotateLeft45:
+        case ActionRequest::RotateRight45:
+        case ActionRequest::RotateLeft90:
+        case ActionRequest::RotateRight90:
+            return tank.facing != UNKNOWN_FACING;
+        case ActionRequest::MoveForward:
+            return tank.facing != UNKNOWN_FACING &&
+                   canStep(tank.row, tank.col, static_cast<Direction>(tank.facing));
+        case ActionRequest::MoveBackward:
+            return tank.facing != UNKNOWN_FACING &&
+                   canStep(tank.row, tank.col, DirectionUtils::rotate180(static_cast<Direction>(tank.facing)));
+        case ActionRequest::Shoot:
+            return tank.facing != UNKNOWN_FACING && tank.shells > 0 &&
+                   shotVictim(tank.row, tank.col, static_cast<Direction>(tank.facing), tank.player) >= 0;
+        default:
+            return false;
+    }
+}
+
+void LookaheadRules_212934582_323964676::apply(int t, ActionRequest action, Undo& undo) {
+    undo.tank = t;
+    undo.before = _tanks[t];
+    undo.victim = -1;
+    if (!isLegal(t, action)) {
+        return;
+    }
+    Tank& tank = _tanks[t];
+    Direction d = static_cast<Direction>(tank.facing);
+    switch (action) {
+        case ActionRequest::RotateLeft45:  tank.facing = static_cast<int>(DirectionUtils::rotate45ccw(d)); break;
+        case ActionRequest::RotateRight45: tank.facing = static_cast<int>(DirectionUtils::rotate45cw(d)); break;
+        case ActionRequest::RotateLeft90:  tank.facing = static_cast<int>(DirectionUtils::rotate90(d, false)); break;
+        case ActionRequest::RotateRight90: tank.facing = static_cast<int>(DirectionUtils::rotate90(d, true)); break;
+        case ActionRequest::MoveForward:
+        case ActionRequest::MoveBackward: {
+            auto [dr, dc] = DirectionUtils::toVector(action == ActionRequest::MoveForward ? d : DirectionUtils::rotate180(d));
+            moveTo(t, tank.row + dr, tank.col + dc);
+            break;
+        }
+        case ActionRequest::Shoot: {
+            int victim = shotVictim(tank.row, tank.col, d, tank.player);
+            --tank.shells;
+            _tanks[victim].alive = false;
+            _occupant[static_cast<size_t>(_tanks[victim].row) * _cols + _tanks[victim].col] = -1;
+            undo.victim = victim;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void LookaheadRules_212934582_323964676::step(int t, Direction d, Undo& undo) {
+    undo.tank = t;
+    undo.before = _tanks[t];
+    undo.victim = -1;
+    auto [dr, dc] = DirectionUtils::toVector(d);
+    moveTo(t, _tanks[t].row + dr, _tanks[t].col + dc);
+}
+
+void LookaheadRules_212934582_323964676::undo(const Undo& undo) {
+    if (undo.victim >= 0) {
+        Tank& victim = _tanks[undo.victim];
+        victim.alive = true;
+        _occupant[static_cast<size_t>(victim.row) * _cols + victim.col] = static_cast<int16_t>(undo.victim);
+    }
+    const Tank& before = undo.before;
+    if (_tanks[undo.tank].row != before.row || _tanks[undo.tank].col != before.col) {
+        moveTo(undo.tank, before.row, before.col);
+    }
+    _tanks[undo.tank] = before;
+}
+
+void LookaheadRules_212934582_323964676::moveTo(int t, int r, int c) {
+    Tank& tank = _tanks[t];
+    _occupant[static_cast<size_t>(tank.row) * _cols + tank.col] = -1;
+    tank.row = r;
+    tank.col = c;
+    _occupant[static_cast<size_t>(r) * _cols + c] = static_cast<int16_t>(t);
+}
+
+} // namespace Algorithm_212934582_323964676
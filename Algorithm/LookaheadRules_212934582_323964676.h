@@ -0,0 +1,107 @@
+#ifndef LOOKAHEADRULES_212934582_323964676_H
+#define LOOKAHEADRULES_212934582_323964676_H
+
+#include "../common/ActionRequest.h"
+#include "../UserCommon/Utils_212934582_323964676.h"  // For Direction and DirectionUtils
+#include "../UserCommon/SharedGrid_212934582_323964676.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace Algorithm_212934582_323964676 {
+
+using UserCommon_212934582_323964676::Direction;
+using UserCommon_212934582_323964676::DirectionUtils;
+
+// The rules GameManager_212934582_323964676 enforces, small enough to play out
+// thousands of turns per decision:
+//  - rotations always succeed;
+//  - a move (forward, or backward against the facing) needs a free target cell
+//    on the map (no wall, mine or tank). A diagonal move is also refused when
+//    either orthogonal cell it squeezes between is taken (the corner-cut rule).
+//    The engine does not insist on that, but AggressiveTankAI plans with it
+//    too: it keeps our paths clear of squeezes and costs the enemy model
+//    little;
+//  - a shot needs a shell and must hit: the first wall, mine or tank on the
+//    ray has to be an enemy, which dies at once. A shot that would miss is
+//    refused and costs nothing.
+// Walls and mines never change during a game, so only tanks are tracked.
+class LookaheadRules_212934582_323964676 {
+public:
+    static constexpr int UNKNOWN_FACING = -1;
+
+    struct Tank {
+        int  row, col;
+        int  facing;                    // Direction, or UNKNOWN_FACING (enemies)
+        int  shells;
+        int  player;                    // 1 or 2
+        bool alive;
+    };
+
+    // What apply() changed, for undo()
+    struct Undo {
+        int  tank;
+        Tank before;
+        int  victim = -1;               // tank killed by a shot, or -1
+    };
+
+    // Read walls, mines and tanks from board[row][col]. Tanks get unknown facing
+    // and no shells; the caller fills in what it knows.
+    void load(const UserCommon_212934582_323964676::Grid& board);
+
+    size_t rows() const { return _rows; }
+    size_t cols() const { return _cols; }
+    std::vector<Tank>& tanks() { return _tanks; }
+    const std::vector<Tank>& tanks() const { return _tanks; }
+
+    // Index of the tank on (r,c), or -1
+    int tankAt(int r, int c) const {
+        return inside(r, c) ? _occupant[static_cast<size_t>(r) * _cols + c] : -1;
+    }
+
+    bool inside(int r, int c) const {
+        return r >= 0 && c >= 0 && static_cast<size_t>(r) < _rows && static_cast<size_t>(c) < _cols;
+    }
+
+    // Off the map, wall, mine or tank
+    bool blocked(int r, int c) const {
+        if (!inside(r, c)) return true;
+        size_t i = static_cast<size_t>(r) * _cols + c;
+        return _terrain[i] != ' ' || _occupant[i] >= 0;
+    }
+
+    // Whether a tank on (r,c) may step one cell in direction d
+    bool canStep(int r, int c, Direction d) const {
+        auto [dr, dc] = DirectionUtils::toVector(d);
+        if (blocked(r + dr, c + dc)) return false;
+        return dr == 0 || dc == 0 || (!blocked(r, c + dc) && !blocked(r + dr, c));
+    }
+
+    // Index of the tank a shot from (r,c) in direction d would kill, or -1 when
+    // a wall, a mine, a tank of `player` or the map edge comes first
+    int shotVictim(int r, int c, Direction d, int player) const;
+
+    // Whether `action` would do anything for tank t (a refused move or shot is a wasted turn)
+    bool isLegal(int t, ActionRequest action) const;
+
+    // Play `action` for tank t. Refused actions change nothing.
+    void apply(int t, ActionRequest action, Undo& undo);
+
+    // Move tank t one cell in direction d regardless of its facing (enemies,
+    // whose facing is unknown, may turn first). d must pass canStep().
+    void step(int t, Direction d, Undo& undo);
+
+    void undo(const Undo& undo);
+
+private:
+    size_t _rows = 0, _cols = 0;
+    std::vector<char>    _terrain;      // ' ', '#' or '@' per cell
+    std::vector<int16_t> _occupant;     // tank index per cell, -1 when free
+    std::vector<Tank>    _tanks;
+
+    void moveTo(int t, int r, int c);
+};
+
+} // namespace Algorithm_212934582_323964676
+
+#endif // LOOKAHEADRULES_212934582_323964676_H
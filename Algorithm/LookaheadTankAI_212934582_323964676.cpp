@@ -0,0 +1,289 @@
+#include "LookaheadTankAI_212934582_323964676.h"
+#include "../UserCommon/MyBattleInfo_212934582_323964676.h"
+#include "../common/TankAlgorithmRegistration.h"
+#include <algorithm>
+#include <cstdlib>
+#include <climits>
+#include <array>
+
+namespace Algorithm_212934582_323964676 {
+
+using UserCommon_212934582_323964676::MyBattleInfo;
+using UserCommon_212934582_323964676::directionTowards;
+using UserCommon_212934582_323964676::rotationCost;
+
+namespace {
+
+constexpr int WIN = 1000000;            // score of killing an enemy, minus the plies it took
+constexpr int MAX_DEPTH = 8;            // our turns; deeper rarely changes the first action
+constexpr uint32_t FAR = UINT32_MAX;    // no line to an enemy reachable
+
+// Our candidate actions, in the order they are tried (a shot first: it ends the line)
+constexpr std::array<ActionRequest, 7> OUR_ACTIONS = {
+    ActionRequest::Shoot,
+    ActionRequest::MoveForward,
+    ActionRequest::RotateLeft45,
+    ActionRequest::RotateRight45,
+    ActionRequest::RotateLeft90,
+    ActionRequest::RotateRight90,
+    ActionRequest::MoveBackward,
+};
+
+} // namespace
+
+LookaheadTankAI_212934582_323964676::LookaheadTankAI_212934582_323964676(int playerIndex, int tankIndex)
+    : _playerIndex(playerIndex)
+    , _tankIndex(tankIndex)
+    , _own(playerIndex)
+    , _x(0)
+    , _y(0)
+    , _gotBattleInfo(false)
+    , _budget(LOOKAHEAD_DECISION_BUDGET_US)
+    , _self(-1)
+    , _opponent(-1)
+    , _nodes(0)
+    , _outOfTime(false)
+{
+}
+
+void LookaheadTankAI_212934582_323964676::updateBattleInfo(BattleInfo& info) {
+    auto& bi = static_cast<MyBattleInfo&>(info);
+
+    _board = bi.board;
+    _x     = bi.x;  // row
+    _y     = bi.y;  // column
+    _own.onBattleInfo(bi.shells_remaining);
+    _gotBattleInfo = true;
+}
+
+ActionRequest LookaheadTankAI_212934582_323964676::getAction() {
+    if (!_gotBattleInfo) {
+        return ActionRequest::GetBattleInfo;
+    }
+    _gotBattleInfo = false;
+    // The budget covers the whole decision, loading the board included
+    _deadline = std::chrono::steady_clock::now() + _budget;
+    _nodes = 0;
+
+    _rules.load(*_board);
+    _self = _rules.tankAt(static_cast<int>(_x), static_cast<int>(_y));
+    if (_self < 0) {
+        return ActionRequest::DoNothing;
+    }
+    auto& tanks = _rules.tanks();
+    tanks[_self].facing = static_cast<int>(_own.direction());
+    tanks[_self].shells = _own.shells();
+
+    // The enemy nearest to us (in moves, ignoring walls) answers our moves
+    _opponent = -1;
+    int nearest = INT_MAX;
+    for (size_t t = 0; t < tanks.size(); ++t) {
+        if (tanks[t].player == _playerIndex) continue;
+        int d = std::max(std::abs(tanks[t].row - tanks[_self].row), std::abs(tanks[t].col - tanks[_self].col));
+        if (d < nearest) {
+            nearest = d;
+            _opponent = static_cast<int>(t);
+        }
+    }
+    if (_opponent < 0) {
+        return ActionRequest::DoNothing;  // nobody left to fight
+    }
+    buildLineDistance();
+
+    // Deepen until the budget runs out; an interrupted depth is discarded,
+    // except at depth 1, whose root actions searched so far still give an answer
+    ActionRequest best = ActionRequest::DoNothing;
+    for (int depth = 1; depth <= MAX_DEPTH; ++depth) {
+        _outOfTime = false;
+        ActionRequest candidate = best;
+        int score = searchRoot(depth, candidate, best);
+        if (_outOfTime) {
+            if (depth == 1) {
+                best = candidate;
+            }
+            break;
+        }
+        best = candidate;
+        if (score >= WIN - MAX_DEPTH * 2) {
+            break;  // a kill is certain; a deeper search cannot improve on it
+        }
+        if (std::chrono::steady_clock::now() >= _deadline) {
+            break;
+        }
+    }
+
+    // A shot the rules allow is one that hits
+    _own.apply(best, best == ActionRequest::Shoot && _rules.isLegal(_self, best));
+    return best;
+}
+
+int LookaheadTankAI_212934582_323964676::searchRoot(int depth, ActionRequest& best, ActionRequest first) {
+    // The previous depth's choice is searched first, so it survives ties and
+    // gives the tightest window to the rest
+    std::array<ActionRequest, OUR_ACTIONS.size()> order = OUR_ACTIONS;
+    std::stable_partition(order.begin(), order.end(), [first](ActionRequest a) { return a == first; });
+
+    int alpha = -WIN - 1;
+    bool any = false;
+    for (ActionRequest action : order) {
+        if (!_rules.isLegal(_self, action)) continue;
+        Rules::Undo undo;
+        _rules.apply(_self, action, undo);
+        int score = undo.victim >= 0 ? WIN - 1 : searchTheirTurn(depth, 1, alpha, WIN + 1);
+        _rules.undo(undo);
+        if (_outOfTime) {
+            return 0;
+        }
+        if (!any || score > alpha) {
+            alpha = score;
+            best = action;
+            any = true;
+        }
+    }
+    return alpha;
+}
+
+int LookaheadTankAI_212934582_323964676::searchOurTurn(int depth, int ply, int alpha, int beta) {
+    if (depth == 0) {
+        return evaluate();
+    }
+    if (timeUp()) {
+        return 0;
+    }
+    int best = -WIN - 1;
+    for (ActionRequest action : OUR_ACTIONS) {
+        if (!_rules.isLegal(_self, action)) continue;
+        Rules::Undo undo;
+        _rules.apply(_self, action, undo);
+        int score = undo.victim >= 0 ? WIN - ply - 1 : searchTheirTurn(depth, ply + 1, alpha, beta);
+        _rules.undo(undo);
+        best = std::max(best, score);
+        alpha = std::max(alpha, score);
+        if (alpha >= beta) {
+            break;
+        }
+    }
+    return best;
+}
+
+int LookaheadTankAI_212934582_323964676::searchTheirTurn(int depth, int ply, int alpha, int beta) {
+    if (timeUp()) {
+        return 0;
+    }
+    // Holding still covers turning in place and shooting at someone else
+    int best = searchOurTurn(depth - 1, ply + 1, alpha, beta);
+    beta = std::min(beta, best);
+    const auto& enemy = _rules.tanks()[_opponent];
+    if (!enemy.alive) {
+        return best;
+    }
+    for (int d = 0; d < 8 && alpha < beta; ++d) {
+        if (!_rules.canStep(enemy.row, enemy.col, static_cast<Direction>(d))) continue;
+        Rules::Undo undo;
+        _rules.step(_opponent, static_cast<Direction>(d), undo);
+        int score = searchOurTurn(depth - 1, ply + 1, alpha, beta);
+        _rules.undo(undo);
+        best = std::min(best, score);
+        beta = std::min(beta, score);
+    }
+    return best;
+}
+
+// Being able to shoot is worth most, then being lined up with an enemy and a
+// turn or two away from facing it, then being few cells from such a line.
+// Every enemy with a clear line to us could fire first, which costs.
+int LookaheadTankAI_212934582_323964676::evaluate() const {
+    const auto& tanks = _rules.tanks();
+    const auto& self = tanks[_self];
+    int ready = INT_MIN;
+    int exposure = 0;
+    for (size_t t = 0; t < tanks.size(); ++t) {
+        const auto& enemy = tanks[t];
+        if (!enemy.alive || enemy.player == self.player) continue;
+        int dr = enemy.row - self.row;
+        int dc = enemy.col - self.col;
+        if (dr != 0 && dc != 0 && std::abs(dr) != std::abs(dc)) continue;
+        Direction d = directionTowards(dr, dc);
+        if (_rules.shotVictim(self.row, self.col, d, self.player) != static_cast<int>(t)) continue;
+        ++exposure;
+        if (self.shells > 0) {
+            ready = std::max(ready, 60 - 25 * rotationCost(static_cast<Direction>(self.facing), d));
+        }
+    }
+    if (ready == INT_MIN) {
+        uint32_t lines = _lineDistance[static_cast<size_t>(self.row) * _rules.cols() + self.col];
+        ready = self.shells == 0 ? 0 : lines == FAR ? -3 * static_cast<int>(_rules.rows() + _rules.cols()) : -3 * static_cast<int>(lines);
+    }
+    return ready - 30 * exposure;
+}
+
+// Cells from which some enemy can be shot are found by walking outward from
+// every enemy until a wall, mine or other tank (our own tank does not count:
+// it will not be there once it moves). A breadth-first search backwards along
+// legal steps then gives every cell's distance to the nearest one. Our tank
+// makes at most MAX_DEPTH moves in a search, so once its own cell is reached
+// the search only needs to go MAX_DEPTH levels further; on large maps that
+// keeps it to the part of the board near us and our enemies.
+void LookaheadTankAI_212934582_323964676::buildLineDistance() {
+    const int R = static_cast<int>(_rules.rows());
+    const int C = static_cast<int>(_rules.cols());
+    const auto& tanks = _rules.tanks();
+    const uint32_t selfCell = static_cast<uint32_t>(tanks[_self].row * C + tanks[_self].col);
+    _lineDistance.assign(static_cast<size_t>(R) * C, FAR);
+    _frontier.clear();
+    for (const auto& enemy : tanks) {
+        if (!enemy.alive || enemy.player == _playerIndex) continue;
+        for (int d = 0; d < 8; ++d) {
+            auto [dr, dc] = DirectionUtils::toVector(static_cast<Direction>(d));
+            for (int r = enemy.row + dr, c = enemy.col + dc; _rules.inside(r, c); r += dr, c += dc) {
+                int occupant = _rules.tankAt(r, c);
+                if ((_rules.blocked(r, c) && occupant < 0) || (occupant >= 0 && occupant != _self)) {
+                    break;
+                }
+                uint32_t cell = static_cast<uint32_t>(r * C + c);
+                if (_lineDistance[cell] != 0) {
+                    _lineDistance[cell] = 0;
+                    _frontier.push_back(cell);
+                }
+            }
+        }
+    }
+    uint32_t limit = FAR;
+    for (size_t i = 0; i < _frontier.size(); ++i) {
+        uint32_t cell = _frontier[i];
+        if (cell == selfCell) {
+            limit = _lineDistance[cell] + MAX_DEPTH;
+        }
+        if (_lineDistance[cell] >= limit) {
+            break;
+        }
+        int r = static_cast<int>(cell) / C;
+        int c = static_cast<int>(cell) % C;
+        uint32_t next = _lineDistance[cell] + 1;
+        for (int d = 0; d < 8; ++d) {
+            auto [dr, dc] = DirectionUtils::toVector(static_cast<Direction>(d));
+            int pr = r - dr, pc = c - dc;  // a tank on (pr,pc) stepping in direction d lands here
+            if (!_rules.inside(pr, pc)) continue;
+            uint32_t prev = static_cast<uint32_t>(pr * C + pc);
+            if (_lineDistance[prev] != FAR) continue;
+            if (_rules.tankAt(pr, pc) != _self && _rules.blocked(pr, pc)) continue;
+            if (!_rules.canStep(pr, pc, static_cast<Direction>(d))) continue;
+            _lineDistance[prev] = next;
+            _frontier.push_back(prev);
+        }
+    }
+}
+
+// Reading the clock costs more than a node, so it is read every 64 nodes
+bool LookaheadTankAI_212934582_323964676::timeUp() {
+    if (!_outOfTime && (++_nodes & 63) == 0 && std::chrono::steady_clock::now() >= _deadline) {
+        _outOfTime = true;
+    }
+    return _outOfTime;
+}
+
+} // namespace Algorithm_212934582_323964676
+
+// Register the lookahead tank algorithm implementation
+using LookaheadAI = Algorithm_212934582_323964676::LookaheadTankAI_212934582_323964676;
+REGISTER_TANK_ALGORITHM(LookaheadAI)
@@ -0,0 +1,86 @@
+#ifndef LOOKAHEADTANKAI_212934582_323964676_H
+#define LOOKAHEADTANKAI_212934582_323964676_H
+
+#include "../common/TankAlgorithm.h"
+#include "../common/BattleInfo.h"
+#include "../common/ActionRequest.h"
+#include "../UserCommon/Utils_212934582_323964676.h"  // For Direction and DirectionUtils
+#include "../UserCommon/SharedGrid_212934582_323964676.h"
+#include "../UserCommon/DeadReckoning_212934582_323964676.h"
+#include "LookaheadRules_212934582_323964676.h"
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+// Wall-clock time one getAction() may spend searching, in microseconds. Set at
+// build time (LOOKAHEAD_BUDGET_US in the Makefile, the CMake cache variable of
+// the same name) or per tank with setDecisionBudget().
+#ifndef LOOKAHEAD_DECISION_BUDGET_US
+#define LOOKAHEAD_DECISION_BUDGET_US 1000
+#endif
+
+namespace Algorithm_212934582_323964676 {
+
+// Iterative-deepening alpha-beta over the next few turns, played out with
+// LookaheadRules. Our tank maximises; the nearest enemy answers each of our
+// turns by stepping to any neighbouring cell or holding still (its facing is
+// not visible, so it is assumed able to turn at will). Each completed depth
+// replaces the chosen action, and the search stops at the deadline, so the
+// answer is the best one the budget allowed.
+class LookaheadTankAI_212934582_323964676 : public TankAlgorithm {
+public:
+    LookaheadTankAI_212934582_323964676(int playerIndex, int tankIndex);
+    ~LookaheadTankAI_212934582_323964676() noexcept override = default;
+
+    // Return the next action for this tank
+    ActionRequest getAction() override;
+
+    // Receive fresh battle information at the start of a round
+    void updateBattleInfo(BattleInfo& info) override;
+
+    void setDecisionBudget(std::chrono::microseconds budget) { _budget = budget; }
+
+private:
+    using Rules = LookaheadRules_212934582_323964676;
+
+    int                            _playerIndex;      // 1 for Player 1
+    int                            _tankIndex;        // zero-based index of this tank
+    UserCommon_212934582_323964676::DeadReckoning _own;  // our facing and shells
+    size_t                         _x, _y;            // current coordinates: _x=row, _y=column (HW2 convention)
+    bool                           _gotBattleInfo;    // whether we've received fresh info
+    UserCommon_212934582_323964676::GridSnapshot _board;  // last round snapshot of entire map (shared, read-only)
+    std::chrono::microseconds      _budget;           // time allowed per decision
+
+    // Search state, rebuilt for every decision
+    Rules                          _rules;
+    int                            _self;             // our index in _rules.tanks()
+    int                            _opponent;         // index of the enemy that answers our moves
+    std::vector<uint32_t>          _lineDistance;     // cells from each cell to one with a clear line to an enemy
+    std::vector<uint32_t>          _frontier;         // breadth-first queue for _lineDistance, kept for its capacity
+    std::chrono::steady_clock::time_point _deadline;
+    size_t                         _nodes;            // nodes visited this decision
+    bool                           _outOfTime;        // the current iteration was cut short
+
+    // Best first action for searching `depth` of our turns ahead; returns its score
+    int searchRoot(int depth, ActionRequest& best, ActionRequest first);
+    int searchOurTurn(int depth, int ply, int alpha, int beta);
+    int searchTheirTurn(int depth, int ply, int alpha, int beta);
+
+    // Static score of the position, from our side
+    int evaluate() const;
+
+    // Breadth-first cell distances to the nearest cell with a clear line to an
+    // enemy, for the cells our tank can reach during the search
+    void buildLineDistance();
+
+    bool timeUp();
+
+public:
+    Direction getDirection() const { return _own.direction(); }
+    int getShellsRemaining() const { return _own.shells(); }
+};
+
+} // namespace Algorithm_212934582_323964676
+
+#endif // LOOKAHEADTANKAI_212934582_323964676_H
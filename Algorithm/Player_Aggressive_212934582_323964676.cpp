@@ -1,6 +1,8 @@
 #include "Player_Aggressive_212934582_323964676.h"
 #include "../common/BattleInfo.h"
 #include "../UserCommon/MyBattleInfo_212934582_323964676.h"
+#include "../UserCommon/BulkSatelliteView_212934582_323964676.h"
+#include "../UserCommon/MoveMask_212934582_323964676.h"
 #include "../common/PlayerRegistration.h"
 
 namespace Algorithm_212934582_323964676 {
@@ -10,35 +12,54 @@ Player_Aggressive_212934582_323964676::Player_Aggressive_212934582_323964676(int
 }
 
 void Player_Aggressive_212934582_323964676::updateTankWithBattleInfo(TankAlgorithm& tank_algo, SatelliteView& satellite_view) {
-    using UserCommon_212934582_323964676::MyBattleInfo;
+    // Everything below that dies with this call (the list of changed cells)
+    // lives in the turn arena; the previous turn's memory is reused
+    turn_arena_.reset();
 
-    // Determine map dimensions by probing the satellite view
-    size_t width = 0;
-    while (satellite_view.getObjectAt(width, 0) != '&') {
-        ++width;
-    }
-    size_t height = 0;
-    while (satellite_view.getObjectAt(0, height) != '&') {
-        ++height;
-    }
-
-    // Reconstruct board and locate our tank (marked by '%')
-    std::vector<std::string> board(height, std::string(width, ' '));
+    // Shares the view's grid when it offers one and locates our tank (marked by '%');
+    // foreign views are read into a fresh grid, a row at a time when they support it
     size_t tank_row = 0, tank_col = 0;
-    for (size_t y = 0; y < height; ++y) {
-        for (size_t x = 0; x < width; ++x) {
-            char c = satellite_view.getObjectAt(x, y);
-            if (c == '%') {
-                tank_row = y;
-                tank_col = x;
-                c = static_cast<char>('0' + player_index_);
+    auto board = UserCommon_212934582_323964676::readSnapshot(
+        satellite_view, static_cast<char>('0' + player_index_), tank_row, tank_col);
+    size_t height = board->size();
+    size_t width = height ? (*board)[0].size() : 0;
+
+    const auto* bulk = UserCommon_212934582_323964676::asBulk(satellite_view);
+    uint64_t sequence = bulk ? bulk->sequence() : 0;
+    std::pmr::vector<UserCommon_212934582_323964676::CellChange> changed(turn_arena_.resource());
+    bool journaled = bulk && bulk->changesSince(sequence, changed);  // empty range: true iff the view keeps a journal
+
+    // Legal-move masks with the corner-cut rule, so the search can expand
+    // neighbours with one lookup instead of re-testing board characters, and the
+    // distance field our tanks take their moves from. All our tanks see the same
+    // enemies, so both are updated once per grid rather than once per tank, and
+    // only around the cells that changed when the view can list them.
+    if (board != masks_board_) {
+        bool incremental = masks_journaled_ && journaled && bulk->changesSince(masks_sequence_, changed);
+        if (incremental) {
+            for (const auto& change : changed) {
+                mask_grid_.cellChanged(*board, change.row, change.col);
             }
-            board[y][x] = c;
+        } else {
+            mask_grid_.build(*board, height, width, /*corner_cut=*/true);
+        }
+        masks_ = std::make_shared<const std::vector<uint8_t>>(mask_grid_.masks());
+        masks_board_ = board;
+        masks_sequence_ = sequence;
+        masks_journaled_ = journaled;
+
+        if (!field_) {
+            field_ = std::make_shared<FiringDistanceField_212934582_323964676>(player_index_);
+            incremental = false;
         }
+        field_->update(board, masks_, incremental ? &changed : nullptr);
     }
 
     // Build battle info with basic data; orientation and shells are not tracked
-    MyBattleInfo info(height, width, board, tank_row, tank_col, 0, num_shells_);
+    FieldBattleInfo_212934582_323964676 info(height, width, board, tank_row, tank_col, 0, num_shells_);
+    info.move_masks = masks_;
+    info.field = field_;
+
     tank_algo.updateBattleInfo(info);
 }
 
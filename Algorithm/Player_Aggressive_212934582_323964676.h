@@ -4,6 +4,13 @@
 #include "../common/Player.h"
 #include "../common/TankAlgorithm.h"
 #include "../common/SatelliteView.h"
+#include "../UserCommon/SharedGrid_212934582_323964676.h"
+#include "../UserCommon/MoveMask_212934582_323964676.h"
+#include "../UserCommon/StepArena_212934582_323964676.h"
+#include "FiringDistanceField_212934582_323964676.h"
+#include <memory>
+#include <vector>
+#include <cstdint>
 
 namespace Algorithm_212934582_323964676 {
 
@@ -19,6 +26,20 @@ private:
     int player_index_;
     size_t x_, y_;
     size_t max_steps_, num_shells_;
+
+    // Move masks of the last grid seen; reused while the grid is unchanged
+    UserCommon_212934582_323964676::GridSnapshot masks_board_;
+    UserCommon_212934582_323964676::MoveMaskGrid mask_grid_;
+    uint64_t masks_sequence_ = 0;
+    bool masks_journaled_ = false;      // mask_grid_ matches board sequence masks_sequence_
+    std::shared_ptr<const std::vector<uint8_t>> masks_;
+
+    // Distance to the nearest firing position, shared by all our tanks; updated
+    // together with the masks, so once per grid rather than once per tank
+    std::shared_ptr<FiringDistanceField_212934582_323964676> field_;
+
+    // Scratch memory for a single updateTankWithBattleInfo() call
+    UserCommon_212934582_323964676::StepArena turn_arena_;
 };
 
 } // namespace Algorithm_212934582_323964676
@@ -0,0 +1,7 @@
+#include "../UserCommon/SnapshotPlayer_212934582_323964676.h"
+#include "../common/PlayerRegistration.h"
+
+// Register the shared snapshot player as the evasive player: the evasive tanks
+// need only the board and their own position
+using PlayerEvasive = UserCommon_212934582_323964676::SnapshotPlayer;
+REGISTER_PLAYER(PlayerEvasive)
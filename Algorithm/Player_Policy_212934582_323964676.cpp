@@ -0,0 +1,7 @@
+#include "../UserCommon/SnapshotPlayer_212934582_323964676.h"
+#include "../common/PlayerRegistration.h"
+
+// Register the shared snapshot player as the policy player: the policy tanks
+// need only the board and their own position
+using PlayerPolicy = UserCommon_212934582_323964676::SnapshotPlayer;
+REGISTER_PLAYER(PlayerPolicy)
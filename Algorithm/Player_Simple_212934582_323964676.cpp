@@ -1,6 +1,7 @@
 #include "Player_Simple_212934582_323964676.h"
 #include "../common/BattleInfo.h"
 #include "../UserCommon/MyBattleInfo_212934582_323964676.h"
+#include "../UserCommon/BulkSatelliteView_212934582_323964676.h"
 #include "../common/PlayerRegistration.h"
 
 namespace Algorithm_212934582_323964676 {
@@ -12,28 +13,12 @@ Player_Simple_212934582_323964676::Player_Simple_212934582_323964676(int player_
 void Player_Simple_212934582_323964676::updateTankWithBattleInfo(TankAlgorithm& tank_algo, SatelliteView& satellite_view) {
     using UserCommon_212934582_323964676::MyBattleInfo;
 
-    size_t width = 0;
-    while (satellite_view.getObjectAt(width, 0) != '&') {
-        ++width;
-    }
-    size_t height = 0;
-    while (satellite_view.getObjectAt(0, height) != '&') {
-        ++height;
-    }
-
-    std::vector<std::string> board(height, std::string(width, ' '));
+    // Shares the view's grid when it offers one; copies the board only for foreign views
     size_t tank_row = 0, tank_col = 0;
-    for (size_t y = 0; y < height; ++y) {
-        for (size_t x = 0; x < width; ++x) {
-            char c = satellite_view.getObjectAt(x, y);
-            if (c == '%') {
-                tank_row = y;
-                tank_col = x;
-                c = static_cast<char>('0' + player_index_);
-            }
-            board[y][x] = c;
-        }
-    }
+    auto board = UserCommon_212934582_323964676::readSnapshot(
+        satellite_view, static_cast<char>('0' + player_index_), tank_row, tank_col);
+    size_t height = board->size();
+    size_t width = height ? (*board)[0].size() : 0;
 
     MyBattleInfo info(height, width, board, tank_row, tank_col, 0, num_shells_);
     tank_algo.updateBattleInfo(info);
@@ -0,0 +1,104 @@
+// PolicyBuilder - builds the Policy library's table from recorded games
+//
+//   policy_builder_212934582_323964676 <table.policy> <record>... [min_samples=<N>]
+//
+// Each record is a file the simulator wrote with record_decisions=<file>: the
+// decisions of every tank in its games, as PolicyFeatures words. For every key
+// the table keeps the action recorded most often (the first in ActionRequest
+// order on a tie), if the key was recorded at least min_samples times (1).
+#include "PolicyTable_212934582_323964676.h"
+#include "../UserCommon/PolicyFeatures_212934582_323964676.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using Algorithm_212934582_323964676::PolicyTable_212934582_323964676;
+using UserCommon_212934582_323964676::PolicyFeatures;
+
+namespace {
+
+constexpr size_t ACTIONS = static_cast<size_t>(ActionRequest::DoNothing) + 1;
+
+void printUsage(const char* prog) {
+    std::cerr << "Usage: " << prog << " <table.policy> <record>... [min_samples=<N>]\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output;
+    std::vector<std::string> records;
+    unsigned long minSamples = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("min_samples=", 0) == 0) {
+            try {
+                minSamples = std::stoul(arg.substr(12));
+            } catch (...) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (output.empty()) {
+            output = arg;
+        } else {
+            records.push_back(arg);
+        }
+    }
+    if (output.empty() || records.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Votes per key and action
+    std::unordered_map<uint64_t, std::array<uint32_t, ACTIONS>> votes;
+    size_t decisions = 0;
+    std::vector<uint64_t> buffer(1 << 16);
+    for (const auto& record : records) {
+        std::ifstream in(record, std::ios::binary);
+        if (!in) {
+            std::cerr << "Cannot read " << record << "\n";
+            return 1;
+        }
+        while (in) {
+            in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(uint64_t)));
+            const size_t words = static_cast<size_t>(in.gcount()) / sizeof(uint64_t);
+            for (size_t w = 0; w < words; ++w) {
+                const uint64_t decision = buffer[w];
+                const size_t action = static_cast<size_t>(PolicyFeatures::actionOf(decision));
+                if (decision == 0 || action >= ACTIONS || PolicyFeatures::actionOf(decision) == ActionRequest::GetBattleInfo) {
+                    continue;
+                }
+                ++votes[PolicyFeatures::keyOf(decision)][action];
+                ++decisions;
+            }
+        }
+    }
+
+    std::vector<uint64_t> table;
+    table.reserve(votes.size());
+    for (const auto& [key, counts] : votes) {
+        size_t best = 0, total = 0;
+        for (size_t a = 0; a < ACTIONS; ++a) {
+            total += counts[a];
+            if (counts[a] > counts[best]) {
+                best = a;
+            }
+        }
+        if (total >= minSamples) {
+            table.push_back(PolicyFeatures::pack(key, static_cast<ActionRequest>(best)));
+        }
+    }
+
+    std::sort(table.begin(), table.end());  // the same records always give the same file
+    if (!PolicyTable_212934582_323964676::write(output, table)) {
+        std::cerr << "Cannot write " << output << "\n";
+        return 1;
+    }
+    std::cout << decisions << " decisions, " << votes.size() << " situations, "
+              << table.size() << " in " << output << std::endl;
+    return 0;
+}
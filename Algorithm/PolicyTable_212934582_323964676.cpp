@@ -0,0 +1,189 @@
+#include "PolicyTable_212934582_323964676.h"
+#include "../UserCommon/PolicyFeatures_212934582_323964676.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Algorithm_212934582_323964676 {
+
+using UserCommon_212934582_323964676::PolicyFeatures;
+
+namespace {
+
+constexpr uint32_t MIN_SLOT_BITS = 4;
+constexpr uint32_t MAX_SLOT_BITS = 40;
+
+// The directory of the file this code was loaded from, with a trailing separator
+std::string libraryDirectory() {
+#ifdef _WIN32
+    HMODULE module = nullptr;
+    char buffer[MAX_PATH];
+    if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                            reinterpret_cast<LPCSTR>(&libraryDirectory), &module)) {
+        return {};
+    }
+    DWORD length = GetModuleFileNameA(module, buffer, MAX_PATH);
+    if (length == 0 || length == MAX_PATH) {
+        return {};
+    }
+    std::string path(buffer, length);
+    size_t slash = path.find_last_of("\\/");
+#else
+    Dl_info info;
+    if (dladdr(reinterpret_cast<void*>(&libraryDirectory), &info) == 0 || !info.dli_fname) {
+        return {};
+    }
+    std::string path = info.dli_fname;
+    size_t slash = path.rfind('/');
+#endif
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
+
+// Give back what open() got the table's bytes with
+void release(void* map, size_t length) {
+#ifdef _WIN32
+    (void)length;
+    delete[] static_cast<uint64_t*>(map);
+#else
+    munmap(map, length);
+#endif
+}
+
+} // namespace
+
+PolicyTable_212934582_323964676::PolicyTable_212934582_323964676(void* map, size_t length)
+    : _map(map)
+    , _length(length)
+{
+    const Header* header = static_cast<const Header*>(map);
+    _slots = reinterpret_cast<const uint64_t*>(header + 1);
+    _slotBits = header->slotBits;
+    _entries = header->entries;
+}
+
+PolicyTable_212934582_323964676::~PolicyTable_212934582_323964676() {
+    release(_map, _length);
+}
+
+std::unique_ptr<const PolicyTable_212934582_323964676> PolicyTable_212934582_323964676::open(const std::string& path) {
+#ifdef _WIN32
+    // No mmap here: each process reads the table into memory, aligned for its slots
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    const std::streamoff size = in ? static_cast<std::streamoff>(in.tellg()) : 0;
+    if (size < static_cast<std::streamoff>(sizeof(Header))) {
+        return nullptr;
+    }
+    size_t length = static_cast<size_t>(size);
+    void* map = new uint64_t[(length + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+    in.seekg(0);
+    if (!in.read(static_cast<char*>(map), size)) {
+        release(map, length);
+        return nullptr;
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    void* map = MAP_FAILED;
+    size_t length = 0;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Header)) {
+        length = static_cast<size_t>(st.st_size);
+        map = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);  // the mapping keeps the file
+    if (map == MAP_FAILED) {
+        return nullptr;
+    }
+#endif
+
+    const Header* header = static_cast<const Header*>(map);
+    const bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                       header->version == VERSION &&
+                       header->slotBits >= MIN_SLOT_BITS && header->slotBits <= MAX_SLOT_BITS &&
+                       length >= sizeof(Header) + (size_t{1} << header->slotBits) * sizeof(uint64_t);
+    if (!valid) {
+        release(map, length);
+        return nullptr;
+    }
+    return std::unique_ptr<const PolicyTable_212934582_323964676>(new PolicyTable_212934582_323964676(map, length));
+}
+
+const PolicyTable_212934582_323964676* PolicyTable_212934582_323964676::shared() {
+    static const std::unique_ptr<const PolicyTable_212934582_323964676> table = [] {
+        std::string path = POLICY_TABLE_FILE;
+        if (!path.empty() && std::filesystem::path(path).is_relative()) {
+            path = libraryDirectory() + path;
+        }
+        return open(path);
+    }();
+    return table.get();
+}
+
+bool PolicyTable_212934582_323964676::write(const std::string& path, const std::vector<uint64_t>& decisions) {
+    uint32_t slotBits = MIN_SLOT_BITS;
+    while ((size_t{1} << slotBits) < 2 * decisions.size()) {
+        ++slotBits;
+    }
+    if (slotBits > MAX_SLOT_BITS) {
+        return false;
+    }
+
+    const size_t mask = (size_t{1} << slotBits) - 1;
+    std::vector<uint64_t> slots(mask + 1, 0);
+    for (uint64_t decision : decisions) {
+        const uint64_t key = PolicyFeatures::keyOf(decision);
+        size_t slot = home(key, slotBits);
+        while (slots[slot] != 0 && PolicyFeatures::keyOf(slots[slot]) != key) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = decision;
+    }
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.slotBits = slotBits;
+    header.entries = decisions.size();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(slots.data()), static_cast<std::streamsize>(slots.size() * sizeof(uint64_t)));
+    return static_cast<bool>(out);
+}
+
+bool PolicyTable_212934582_323964676::find(uint64_t key, ActionRequest& action) const {
+    const size_t mask = (size_t{1} << _slotBits) - 1;
+    size_t slot = home(key, _slotBits);
+    for (size_t probe = 0; probe <= mask; ++probe, slot = (slot + 1) & mask) {
+        const uint64_t decision = _slots[slot];
+        if (decision == 0) {
+            return false;
+        }
+        if (PolicyFeatures::keyOf(decision) == key) {
+            action = PolicyFeatures::actionOf(decision);
+            return true;
+        }
+    }
+    return false;
+}
+
+// splitmix64's finaliser; its top bits pick the slot
+size_t PolicyTable_212934582_323964676::home(uint64_t key, uint32_t slotBits) {
+    uint64_t z = key + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return static_cast<size_t>(z >> (64 - slotBits));
+}
+
+} // namespace Algorithm_212934582_323964676
@@ -0,0 +1,69 @@
+#ifndef POLICYTABLE_212934582_323964676_H
+#define POLICYTABLE_212934582_323964676_H
+
+#include "../common/ActionRequest.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// The table the Policy library opens, next to the library unless an absolute path
+#ifndef POLICY_TABLE_FILE
+#define POLICY_TABLE_FILE "Algorithm_Policy_212934582_323964676.policy"
+#endif
+
+namespace Algorithm_212934582_323964676 {
+
+// An action per PolicyFeatures key, in a file that is mapped read-only, so one
+// copy in memory serves every game and thread in the process, and any other
+// process reading the same file (on Windows each process reads it into memory). The file is a Header and then 2^slotBits
+// slots: an open-addressing hash table of PolicyFeatures decision words (key
+// and action, 0 for an empty slot), probed linearly from the key's hash and
+// at most half full, so a lookup is a few probes. In host byte order.
+class PolicyTable_212934582_323964676 {
+public:
+    struct Header {
+        char     magic[8];  // MAGIC
+        uint32_t version;   // VERSION
+        uint32_t slotBits;
+        uint64_t entries;
+    };
+    static constexpr char MAGIC[8] = {'T', 'N', 'K', 'P', 'O', 'L', 'C', 'Y'};
+    static constexpr uint32_t VERSION = 1;
+
+    ~PolicyTable_212934582_323964676();
+    PolicyTable_212934582_323964676(const PolicyTable_212934582_323964676&) = delete;
+    PolicyTable_212934582_323964676& operator=(const PolicyTable_212934582_323964676&) = delete;
+
+    // Map the table at `path`; null when it is missing or not a table
+    static std::unique_ptr<const PolicyTable_212934582_323964676> open(const std::string& path);
+
+    // The table of this library, POLICY_TABLE_FILE, mapped on first use; null
+    // when there is none
+    static const PolicyTable_212934582_323964676* shared();
+
+    // Write a table of `decisions` (PolicyFeatures words, one per key) to `path`
+    static bool write(const std::string& path, const std::vector<uint64_t>& decisions);
+
+    // The action stored for `key`, if any
+    bool find(uint64_t key, ActionRequest& action) const;
+
+    size_t size() const { return _entries; }
+
+private:
+    PolicyTable_212934582_323964676(void* map, size_t length);
+
+    void*           _map;      // the whole file
+    size_t          _length;
+    const uint64_t* _slots;
+    uint32_t        _slotBits;
+    size_t          _entries;
+
+    // The first slot probed for `key`
+    static size_t home(uint64_t key, uint32_t slotBits);
+};
+
+} // namespace Algorithm_212934582_323964676
+
+#endif // POLICYTABLE_212934582_323964676_H
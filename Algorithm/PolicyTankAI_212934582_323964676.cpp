@@ -0,0 +1,82 @@
+#include "PolicyTankAI_212934582_323964676.h"
+#include "../UserCommon/MyBattleInfo_212934582_323964676.h"
+#include "../common/TankAlgorithmRegistration.h"
+
+namespace Algorithm_212934582_323964676 {
+
+using UserCommon_212934582_323964676::MyBattleInfo;
+using UserCommon_212934582_323964676::PolicyFeatures;
+
+PolicyTankAI_212934582_323964676::PolicyTankAI_212934582_323964676(int playerIndex, int tankIndex)
+    : _playerIndex(playerIndex)
+    , _tankIndex(tankIndex)
+    , _own(playerIndex)
+    , _x(0)
+    , _y(0)
+    , _rows(0)
+    , _cols(0)
+    , _gotBattleInfo(false)
+    , _table(PolicyTable_212934582_323964676::shared())
+{
+}
+
+void PolicyTankAI_212934582_323964676::updateBattleInfo(BattleInfo& info) {
+    auto& bi = static_cast<MyBattleInfo&>(info);
+
+    _rows  = bi.rows;
+    _cols  = bi.cols;
+    _board = bi.board;
+    _x     = bi.x;  // row
+    _y     = bi.y;  // column
+    _own.onBattleInfo(bi.shells_remaining);
+    _gotBattleInfo = true;
+}
+
+ActionRequest PolicyTankAI_212934582_323964676::getAction() {
+    if (!_gotBattleInfo) {
+        return ActionRequest::GetBattleInfo;
+    }
+    _gotBattleInfo = false;
+
+    if (_x >= _rows || _y >= _cols) {
+        return ActionRequest::DoNothing;
+    }
+
+    const PolicyFeatures features = PolicyFeatures::describe(
+        *_board, _x, _y, static_cast<int>(_own.direction()), static_cast<size_t>(_own.shells()), _playerIndex);
+    ActionRequest action;
+    if (!_table || !_table->find(features.key(), action) || action > ActionRequest::DoNothing ||
+        action == ActionRequest::GetBattleInfo || (action == ActionRequest::Shoot && _own.shells() == 0)) {
+        action = fallback(features);
+    }
+
+    _own.apply(action, features.onTarget);
+    return action;
+}
+
+ActionRequest PolicyTankAI_212934582_323964676::fallback(const PolicyFeatures& features) const {
+    if (features.onTarget) {
+        return ActionRequest::Shoot;
+    }
+    if (features.enemyDirection != PolicyFeatures::NO_ENEMY && features.enemyDirection != features.facing) {
+        // Clockwise eighths from our facing to the enemy's
+        switch ((features.enemyDirection - features.facing + 8) % 8) {
+            case 1:  return ActionRequest::RotateRight45;
+            case 7:  return ActionRequest::RotateLeft45;
+            case 2:
+            case 3:
+            case 4:  return ActionRequest::RotateRight90;
+            default: return ActionRequest::RotateLeft90;
+        }
+    }
+    if (features.ring[features.facing] == PolicyFeatures::EMPTY) {
+        return ActionRequest::MoveForward;
+    }
+    return ActionRequest::RotateRight45;
+}
+
+} // namespace Algorithm_212934582_323964676
+
+// Register the policy tank algorithm implementation
+using PolicyAI = Algorithm_212934582_323964676::PolicyTankAI_212934582_323964676;
+REGISTER_TANK_ALGORITHM(PolicyAI)
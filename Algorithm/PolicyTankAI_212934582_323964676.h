@@ -0,0 +1,55 @@
+#ifndef POLICYTANKAI_212934582_323964676_H
+#define POLICYTANKAI_212934582_323964676_H
+
+#include "../common/TankAlgorithm.h"
+#include "../common/BattleInfo.h"
+#include "../common/ActionRequest.h"
+#include "../UserCommon/Utils_212934582_323964676.h"  // For Direction and DirectionUtils
+#include "../UserCommon/SharedGrid_212934582_323964676.h"
+#include "../UserCommon/PolicyFeatures_212934582_323964676.h"
+#include "../UserCommon/DeadReckoning_212934582_323964676.h"
+#include "PolicyTable_212934582_323964676.h"
+#include <cstddef>
+
+namespace Algorithm_212934582_323964676 {
+
+using UserCommon_212934582_323964676::Direction;
+using UserCommon_212934582_323964676::DirectionUtils;
+
+// Plays from a table: every turn it describes its situation as PolicyFeatures
+// and takes the action the PolicyTable holds for that key, which is what the
+// recorded tanks did most often there. No search, so a decision costs the same
+// on any map. Situations the table does not know get a simple rule: shoot when
+// on target, otherwise turn toward the nearest enemy and advance.
+class PolicyTankAI_212934582_323964676 : public TankAlgorithm {
+public:
+    PolicyTankAI_212934582_323964676(int playerIndex, int tankIndex);
+    ~PolicyTankAI_212934582_323964676() noexcept override = default;
+
+    // Return the next action for this tank
+    ActionRequest getAction() override;
+
+    // Receive fresh battle information at the start of a round
+    void updateBattleInfo(BattleInfo& info) override;
+
+private:
+    int                            _playerIndex;      // 1 for Player 1
+    int                            _tankIndex;        // zero-based index of this tank
+    UserCommon_212934582_323964676::DeadReckoning _own;  // our facing and shells
+    size_t                         _x, _y;            // current coordinates: _x=row, _y=column (HW2 convention)
+    size_t                         _rows, _cols;      // map dimensions
+    bool                           _gotBattleInfo;    // whether we've received fresh info
+    UserCommon_212934582_323964676::GridSnapshot _board;  // last round snapshot of entire map (shared, read-only)
+    const PolicyTable_212934582_323964676* _table;    // shared by every tank in the process, null when there is none
+
+    // The rule for situations the table does not cover
+    ActionRequest fallback(const UserCommon_212934582_323964676::PolicyFeatures& features) const;
+
+public:
+    Direction getDirection() const { return _own.direction(); }
+    int getShellsRemaining() const { return _own.shells(); }
+};
+
+} // namespace Algorithm_212934582_323964676
+
+#endif // POLICYTANKAI_212934582_323964676_H
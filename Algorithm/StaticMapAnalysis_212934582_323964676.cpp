@@ -0,0 +1,257 @@
+#include "StaticMapAnalysis_212934582_323964676.h"
+#include "../UserCommon/Utils_212934582_323964676.h"  // For Direction and DirectionUtils
+#include "../UserCommon/BoardScan_212934582_323964676.h"
+#include <algorithm>
+#include <future>
+#include <list>
+#include <mutex>
+#include <cstring>
+
+namespace Algorithm_212934582_323964676 {
+
+using UserCommon_212934582_323964676::BoardScan;
+using UserCommon_212934582_323964676::CharSet;
+using UserCommon_212934582_323964676::Direction;
+using UserCommon_212934582_323964676::DirectionUtils;
+
+namespace {
+
+// Layouts kept after their last game ended; a competition cycles through a few
+// maps, and a landmark table of a 1000x1000 map takes 16 MB
+constexpr size_t CACHE_CAPACITY = 4;
+
+using Analysis = std::shared_ptr<const StaticMapAnalysis_212934582_323964676>;
+
+// A layout and its analysis, which is ready once the game that first met the
+// layout has built it
+struct LayoutEntry {
+    uint64_t hash;
+    size_t rows, cols;
+    std::vector<uint8_t> blocked;
+    std::shared_future<Analysis> analysis;
+};
+
+// The layouts of this library, most recently used first. Each algorithm
+// library keeps its own.
+struct LayoutCache {
+    std::mutex mutex;
+    std::list<LayoutEntry> entries;
+};
+
+LayoutCache& layoutCache() {
+    static LayoutCache cache;
+    return cache;
+}
+
+} // namespace
+
+std::shared_ptr<const StaticMapAnalysis_212934582_323964676> StaticMapAnalysis_212934582_323964676::forBoard(
+    const UserCommon_212934582_323964676::Grid& board) {
+    static const CharSet walls_and_mines("#@");
+    const size_t rows = board.size();
+    const size_t cols = rows ? board[0].size() : 0;
+    const size_t width = cols + 2;
+    std::vector<uint8_t> blocked((rows + 2) * width, 1);
+    for (size_t r = 0; r < rows; ++r) {
+        const std::string& line = board[r];
+        BoardScan::markMembers(line.data(), std::min(cols, line.size()), walls_and_mines, &blocked[(r + 1) * width + 1]);
+    }
+    const uint64_t hash = layoutHash(blocked);
+
+    LayoutCache& cache = layoutCache();
+    std::promise<Analysis> promise;
+    const LayoutEntry* mine = nullptr;
+    std::shared_future<Analysis> pending;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        for (auto it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+            if (it->hash == hash && it->rows == rows && it->cols == cols && it->blocked == blocked) {
+                cache.entries.splice(cache.entries.begin(), cache.entries, it);
+                pending = it->analysis;
+                break;
+            }
+        }
+        if (!pending.valid()) {
+            // New layout: claim it, so games that meet it meanwhile wait for
+            // this build instead of starting their own
+            cache.entries.push_front(LayoutEntry{hash, rows, cols, blocked, promise.get_future().share()});
+            mine = &cache.entries.front();
+            if (cache.entries.size() > CACHE_CAPACITY) {
+                cache.entries.pop_back();  // a waiter keeps its own copy of the future
+            }
+        }
+    }
+    if (!mine) {
+        return pending.get();
+    }
+
+    // Analysing takes a few breadth-first passes over the map; games on other
+    // maps should not wait for it
+    try {
+        auto built = std::make_shared<const StaticMapAnalysis_212934582_323964676>(rows, cols, std::move(blocked));
+        promise.set_value(built);
+        return built;
+    } catch (...) {
+        // Waiters get the error; the next game to meet the layout tries again
+        promise.set_exception(std::current_exception());
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.entries.remove_if([mine](const LayoutEntry& entry) { return &entry == mine; });
+        throw;
+    }
+}
+
+StaticMapAnalysis_212934582_323964676::StaticMapAnalysis_212934582_323964676(size_t rows, size_t cols, std::vector<uint8_t> blocked)
+    : _rows(rows)
+    , _cols(cols)
+    , _blocked(std::move(blocked))
+    , _landmarkCount(0)
+{
+    const ptrdiff_t width = static_cast<ptrdiff_t>(cols) + 2;
+    for (int d = 0; d < 8; ++d) {
+        auto [dr, dc] = DirectionUtils::toVector(static_cast<Direction>(d));
+        bool diagonal = dr != 0 && dc != 0;
+        _step[d] = dr * width + dc;
+        _sideRow[d] = diagonal ? dr * width : 0;
+        _sideCol[d] = diagonal ? dc : 0;
+    }
+    labelComponents();
+    if (rows * cols >= ClusterGraph_212934582_323964676::MIN_CELLS) {
+        _clusters = std::make_unique<const ClusterGraph_212934582_323964676>(*this);
+    } else {
+        placeLandmarks();
+    }
+}
+
+// FNV-1a over eight cells at a time
+uint64_t StaticMapAnalysis_212934582_323964676::layoutHash(const std::vector<uint8_t>& blocked) {
+    uint64_t hash = 1469598103934665603ULL;
+    size_t i = 0;
+    for (; i + 8 <= blocked.size(); i += 8) {
+        uint64_t word;
+        std::memcpy(&word, &blocked[i], sizeof(word));
+        hash = (hash ^ word) * 1099511628211ULL;
+    }
+    for (; i < blocked.size(); ++i) {
+        hash = (hash ^ blocked[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+template <class F>
+void StaticMapAnalysis_212934582_323964676::forEachStep(size_t p, F&& f) const {
+    for (int d = 0; d < 8; ++d) {
+        size_t q = p + _step[d];
+        if (_blocked[q]) continue;
+        if (_sideRow[d] != 0 && (_blocked[p + _sideRow[d]] || _blocked[p + _sideCol[d]])) continue;
+        f(q);
+    }
+}
+
+void StaticMapAnalysis_212934582_323964676::labelComponents() {
+    const size_t width = _cols + 2;
+    auto cellOf = [&](size_t p) { return (p / width - 1) * _cols + p % width - 1; };
+    _component.assign(_rows * _cols, NO_COMPONENT);
+    std::vector<size_t> queue;
+    uint32_t next = 0;
+    for (size_t r = 0; r < _rows; ++r) {
+        for (size_t c = 0; c < _cols; ++c) {
+            size_t p = (r + 1) * width + c + 1;
+            if (_blocked[p] || _component[r * _cols + c] != NO_COMPONENT) continue;
+            const uint32_t label = next++;
+            _component[r * _cols + c] = label;
+            queue.assign(1, p);
+            for (size_t i = 0; i < queue.size(); ++i) {
+                forEachStep(queue[i], [&](size_t q) {
+                    uint32_t& component = _component[cellOf(q)];
+                    if (component == NO_COMPONENT) {
+                        component = label;
+                        queue.push_back(q);
+                    }
+                });
+            }
+        }
+    }
+}
+
+// Farthest-point landmarks in the largest component: the first is the cell
+// farthest from an arbitrary one, each next the cell farthest from all chosen
+// so far. Smaller components get none; their cells have no bound.
+void StaticMapAnalysis_212934582_323964676::placeLandmarks() {
+    const size_t cells = _rows * _cols;
+    std::vector<size_t> sizes;
+    for (uint32_t component : _component) {
+        if (component == NO_COMPONENT) continue;
+        if (sizes.size() <= component) sizes.resize(component + 1, 0);
+        ++sizes[component];
+    }
+    if (sizes.empty()) {
+        return;
+    }
+    const uint32_t largest = static_cast<uint32_t>(std::max_element(sizes.begin(), sizes.end()) - sizes.begin());
+
+    // Cells of the largest component by how far they are from the nearest
+    // landmark; to begin with, from its first cell
+    std::vector<uint16_t> nearest(cells);
+    size_t first = std::find(_component.begin(), _component.end(), largest) - _component.begin();
+    if (!distancesFrom(first, nearest.data())) {
+        return;
+    }
+    auto farthest = [&]() {
+        size_t best = first;
+        for (size_t cell = 0; cell < cells; ++cell) {
+            if (_component[cell] == largest && nearest[cell] > nearest[best]) best = cell;
+        }
+        return best;
+    };
+
+    std::vector<uint16_t> tables(MAX_LANDMARKS * cells);
+    for (size_t landmark = farthest(); _landmarkCount < MAX_LANDMARKS; landmark = farthest()) {
+        if (_landmarkCount > 0 && nearest[landmark] == 0) {
+            break;  // every cell is a landmark already
+        }
+        uint16_t* table = &tables[_landmarkCount * cells];
+        if (!distancesFrom(landmark, table)) {
+            break;
+        }
+        uint16_t range = 0;
+        for (size_t cell = 0; cell < cells; ++cell) {
+            if (table[cell] == FAR) continue;
+            range = std::max(range, table[cell]);
+            nearest[cell] = _landmarkCount == 0 ? table[cell] : std::min(nearest[cell], table[cell]);
+        }
+        _landmarkRange.push_back(range);
+        ++_landmarkCount;
+    }
+
+    _landmarkDist.resize(_landmarkCount * cells);
+    for (size_t k = 0; k < _landmarkCount; ++k) {
+        for (size_t cell = 0; cell < cells; ++cell) {
+            _landmarkDist[cell * _landmarkCount + k] = tables[k * cells + cell];
+        }
+    }
+}
+
+bool StaticMapAnalysis_212934582_323964676::distancesFrom(size_t cell, uint16_t* out) const {
+    const size_t width = _cols + 2;
+    auto cellOf = [&](size_t p) { return (p / width - 1) * _cols + p % width - 1; };
+    std::fill(out, out + _rows * _cols, FAR);
+    out[cell] = 0;
+    std::vector<size_t> queue(1, (cell / _cols + 1) * width + cell % _cols + 1);
+    queue.reserve(_rows * _cols);
+    for (size_t i = 0; i < queue.size(); ++i) {
+        const uint16_t next = static_cast<uint16_t>(out[cellOf(queue[i])] + 1);
+        if (next == FAR) {
+            return false;
+        }
+        forEachStep(queue[i], [&](size_t q) {
+            uint16_t& dist = out[cellOf(q)];
+            if (dist == FAR) {
+                dist = next;
+                queue.push_back(q);
+            }
+        });
+    }
+    return true;
+}
+
+} // namespace Algorithm_212934582_323964676
@@ -0,0 +1,97 @@
+#ifndef STATICMAPANALYSIS_212934582_323964676_H
+#define STATICMAPANALYSIS_212934582_323964676_H
+
+#include "../UserCommon/SharedGrid_212934582_323964676.h"
+#include "../UserCommon/Utils_212934582_323964676.h"  // For Direction
+#include "ClusterGraph_212934582_323964676.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+namespace Algorithm_212934582_323964676 {
+
+// What the walls and mines of a map say about moving on it, whatever tanks are
+// on the board: every game on a map starts from the same walls and mines, so
+// the analysis is built once per layout and shared by all of them, in every
+// thread. Steps follow the planning rule (corner-cut on); tanks only ever
+// block more steps, so for any board with this layout
+//  - two cells with different component() can never reach each other, and
+//  - |landmarkDistances(a)[k] - landmarkDistances(b)[k]| is at most the number
+//    of steps from a to b, for every landmark k: an admissible and consistent
+//    search heuristic (ALT).
+// Maps of ClusterGraph::MIN_CELLS or more get a ClusterGraph for routing
+// instead of landmarks.
+// Cells are r * cols + c. Immutable once built.
+class StaticMapAnalysis_212934582_323964676 {
+public:
+    static constexpr uint32_t NO_COMPONENT = UINT32_MAX;  // walls and mines
+    static constexpr uint16_t FAR = UINT16_MAX;           // not reached from the landmark
+    static constexpr size_t MAX_LANDMARKS = 8;
+
+    // The analysis of `board`'s walls and mines, from a process-wide cache of
+    // the most recently used layouts. The first caller for a new layout builds
+    // it outside the cache's lock; later callers for that layout wait for it,
+    // callers for other layouts do not. Safe to call from any thread.
+    static std::shared_ptr<const StaticMapAnalysis_212934582_323964676> forBoard(const UserCommon_212934582_323964676::Grid& board);
+
+    // Analyse a layout: blocked is (rows + 2) x (cols + 2), 1 for a wall, a
+    // mine or the border around the map
+    StaticMapAnalysis_212934582_323964676(size_t rows, size_t cols, std::vector<uint8_t> blocked);
+
+    size_t rows() const { return _rows; }
+    size_t cols() const { return _cols; }
+
+    // Whether (r,c) holds a wall or a mine in the analysed layout
+    bool isStatic(size_t r, size_t c) const { return _blocked[(r + 1) * (_cols + 2) + c + 1] != 0; }
+
+    // Whether a tank on `cell` may step in direction d past the walls and
+    // mines alone (on the board and, diagonally, not between two of them)
+    bool canStep(size_t cell, UserCommon_212934582_323964676::Direction d) const {
+        const size_t p = (cell / _cols + 1) * (_cols + 2) + cell % _cols + 1;
+        const int i = static_cast<int>(d);
+        return !_blocked[p + _step[i]] &&
+               (_sideRow[i] == 0 || (!_blocked[p + _sideRow[i]] && !_blocked[p + _sideCol[i]]));
+    }
+
+    uint32_t component(size_t cell) const { return _component[cell]; }
+
+    size_t landmarkCount() const { return _landmarkCount; }
+    // Steps from each landmark to `cell`, landmarkCount() of them, FAR from a
+    // landmark that cannot reach it. Kept together so that a bound is one read.
+    const uint16_t* landmarkDistances(size_t cell) const { return &_landmarkDist[cell * _landmarkCount]; }
+    // The largest distance from landmark k other than FAR
+    uint16_t landmarkRange(size_t k) const { return _landmarkRange[k]; }
+
+    // The routing graph of a large map, null for a smaller one
+    const ClusterGraph_212934582_323964676* clusters() const { return _clusters.get(); }
+
+private:
+    size_t                         _rows, _cols;
+    std::vector<uint8_t>           _blocked;          // padded layout, as given to the constructor
+    std::vector<uint32_t>          _component;        // per cell, NO_COMPONENT for walls and mines
+    size_t                         _landmarkCount;
+    std::vector<uint16_t>          _landmarkDist;     // per cell, _landmarkCount distances
+    std::vector<uint16_t>          _landmarkRange;    // per landmark
+    std::unique_ptr<const ClusterGraph_212934582_323964676> _clusters;
+
+    // Offsets of the 8 steps in the padded layout, and of the two cells a
+    // diagonal step squeezes between (0 for straight steps)
+    ptrdiff_t                      _step[8], _sideRow[8], _sideCol[8];
+
+    static uint64_t layoutHash(const std::vector<uint8_t>& blocked);
+
+    // Call f(next) for each padded cell one legal step from padded cell p
+    template <class F> void forEachStep(size_t p, F&& f) const;
+
+    void labelComponents();
+    void placeLandmarks();
+
+    // Breadth-first steps from `cell` into out[cell]; false when some distance
+    // does not fit below FAR
+    bool distancesFrom(size_t cell, uint16_t* out) const;
+};
+
+} // namespace Algorithm_212934582_323964676
+
+#endif // STATICMAPANALYSIS_212934582_323964676_H
@@ -1,9 +1,14 @@
 #include "GameManager_212934582_323964676.h"
 #include "MySatelliteView.h"
+#include "PackedSatelliteView.h"
 #include "../UserCommon/MyBattleInfo_212934582_323964676.h"
 #include "../common/ActionRequest.h"
 #include "../UserCommon/Utils_212934582_323964676.h"  // For Direction and DirectionUtils
+#include "../UserCommon/BulkSatelliteView_212934582_323964676.h"
+#include "../UserCommon/PolicyFeatures_212934582_323964676.h"
 #include <iostream>
+#include <fstream>
+#include <mutex>
 #include <algorithm>
 #include "../UserCommon/MyBattleInfo_212934582_323964676.h"
 namespace GameManager_212934582_323964676 {
@@ -12,9 +17,10 @@ namespace GameManager_212934582_323964676 {
 using UserCommon_212934582_323964676::Direction;
 using UserCommon_212934582_323964676::DirectionUtils;
 using UserCommon_212934582_323964676::MyBattleInfo;
+using UserCommon_212934582_323964676::PolicyFeatures;
 
 GameManager_212934582_323964676::GameManager_212934582_323964676(bool verbose)
-    : verbose_(verbose), last_hit_position_(std::make_pair(0, 0)), last_hit_player_(0) {
+    : verbose_(verbose) {
 }
 
 GameResult GameManager_212934582_323964676::run(
@@ -35,31 +41,58 @@ GameResult GameManager_212934582_323964676::run(
         std::cout << "GameManager::run() called with " << map_width << "x" << map_height << std::endl;
     }
 
+    // All per-game state lives here, never in the manager instance
+    GameContext ctx(map_width, map_height);
+
     // Initialize game board from SatelliteView (extract once, store locally like HW2)
-    board_.clear();
-    board_.resize(map_height);
+    ctx.board.resize(map_height);
+    const auto* bulk_map = UserCommon_212934582_323964676::asBulk(map);
     for (size_t y = 0; y < map_height; ++y) {
-        board_[y].resize(map_width, ' ');  // Initialize with spaces
+        ctx.board[y].resize(map_width, ' ');  // Initialize with spaces
+        if (bulk_map) {
+            bulk_map->copyRow(y, 0, map_width, &ctx.board[y][0]);  // whole row at once
+            continue;
+        }
         for (size_t x = 0; x < map_width; ++x) {
             try {
-                board_[y][x] = map.getObjectAt(x, y);
+                ctx.board[y][x] = map.getObjectAt(x, y);
             } catch (...) {
-                board_[y][x] = '?';  // Safe fallback
+                ctx.board[y][x] = '?';  // Safe fallback
             }
         }
     }
-
-
+    ctx.move_masks.build(ctx.board, map_height, map_width, /*corner_cut=*/false);
+    {
+        UserCommon_212934582_323964676::Grid& view = ctx.view.mutate();
+        view = ctx.board;
+        for (auto& row : view) {
+            std::transform(row.begin(), row.end(), row.begin(), MySatelliteView::sanitize);
+        }
+    }
 
     // Find initial tank positions and create tank states
-    std::vector<TankState> player1_tanks = findTanks(map, map_width, map_height, 1, num_shells);
-    std::vector<TankState> player2_tanks = findTanks(map, map_width, map_height, 2, num_shells);
+    std::vector<TankState> player1_tanks = findTanks(ctx, 1, num_shells);
+    std::vector<TankState> player2_tanks = findTanks(ctx, 2, num_shells);
+
+    // One algorithm per tank for the whole game (created on the tank's first turn),
+    // so an algorithm can keep state between turns
+    std::vector<std::unique_ptr<TankAlgorithm>> player1_algos(player1_tanks.size());
+    std::vector<std::unique_ptr<TankAlgorithm>> player2_algos(player2_tanks.size());
 
     if (verbose_) {
         std::cout << "Player 1 has " << player1_tanks.size() << " tanks" << std::endl;
         std::cout << "Player 2 has " << player2_tanks.size() << " tanks" << std::endl;
     }
 
+    // Every decision, described as the tank saw the board, when recording
+    std::vector<uint64_t> decisions;
+    auto recordDecision = [&](const TankState& tank, ActionRequest action) {
+        if (decision_record_.empty()) return;
+        PolicyFeatures features = PolicyFeatures::describe(ctx.view.get(), tank.y, tank.x, tank.facing,
+                                                           tank.shells_remaining, tank.player_id);
+        decisions.push_back(PolicyFeatures::pack(features.key(), action));
+    };
+
     // Basic game loop - run through steps (limited to 3 steps for testing)
     size_t current_step = 0;
     bool game_over = false;
@@ -67,77 +100,18 @@ GameResult GameManager_212934582_323964676::run(
 
     while (current_step < debug_max_steps && !game_over) {
         current_step++;
+        ctx.step_arena.reset();  // nothing allocated from it survives a step
 
         if (verbose_) {
             std::cout << "\n=== Step " << current_step << " of " << debug_max_steps << " ===" << std::endl;
         }
 
         // ADVANCE ALL FLYING SHELLS (from HW2 flying shell system)
-        if (verbose_) {
-            std::cout << "  Advancing " << live_shells_.size() << " flying shells..." << std::endl;
-        }
-
-        std::vector<ShellState> still_flying;
-        for (auto& shell : live_shells_) {
-            // toVector returns (dRow, dCol)
-            auto [dRow, dCol] = DirectionUtils::toVector(static_cast<Direction>(shell.dir));
-            int new_x = static_cast<int>(shell.x) + dCol; // column += col delta
-            int new_y = static_cast<int>(shell.y) + dRow; // row    += row delta
-
-            // Check if shell goes out of bounds
-            if (new_x < 0 || new_y < 0 ||
-                static_cast<size_t>(new_x) >= map_width ||
-                static_cast<size_t>(new_y) >= map_height) {
-                if (verbose_) {
-                    std::cout << "    Shell at (" << shell.x << "," << shell.y << ") goes out of bounds" << std::endl;
-                }
-                continue;  // Shell destroyed
-            }
-
-            // Check if shell hits a wall
-            if (board_[new_y][new_x] == '#') {
-                if (verbose_) {
-                    std::cout << "    Shell at (" << shell.x << "," << shell.y << ") hits wall at (" << new_x << "," << new_y << ")" << std::endl;
-                }
-                continue;  // Shell destroyed
-            }
-
-            // Check if shell hits a tank
-            char cell = board_[new_y][new_x];
-            if (cell == '1' || cell == '2') {
-                if (verbose_) {
-                    std::cout << "    Shell at (" << shell.x << "," << shell.y << ") hits tank '" << cell << "' at (" << new_x << "," << new_y << ")!" << std::endl;
-                }
-
-                // Clear the tank from board
-                board_[new_y][new_x] = ' ';
-
-                // Store hit information for tank destruction
-                last_hit_position_ = std::make_pair(new_x, new_y);
-                last_hit_player_ = (cell == '1') ? 1 : 2;
-
-                continue;  // Shell destroyed
-            }
-
-            // Shell continues flying
-            shell.x = static_cast<size_t>(new_x);
-            shell.y = static_cast<size_t>(new_y);
-            still_flying.push_back(shell);
-
-            if (verbose_) {
-                std::cout << "    Shell advances to (" << shell.x << "," << shell.y << ")" << std::endl;
-            }
-        }
-
-        // Update live shells list
-        live_shells_.swap(still_flying);
-
-        if (verbose_) {
-            std::cout << "  " << live_shells_.size() << " shells still flying" << std::endl;
-        }
+        advanceShells(ctx);
 
         // Execute player 1 turns
-        for (auto& tank : player1_tanks) {
+        for (size_t i = 0; i < player1_tanks.size(); ++i) {
+            TankState& tank = player1_tanks[i];
             if (!tank.is_alive) continue;  // Skip dead tanks
 
             if (verbose_) {
@@ -146,50 +120,29 @@ GameResult GameManager_212934582_323964676::run(
                           << " shells:" << tank.shells_remaining << std::endl;
             }
 
-            // Create tank algorithm instance
-            auto tank_ai = player1_tank_algo_factory(tank.player_id, tank.tank_id);
+            // Create the tank's algorithm instance on its first turn
+            auto& tank_ai = player1_algos[i];
+            if (!tank_ai) {
+                tank_ai = player1_tank_algo_factory(tank.player_id, tank.tank_id);
+            }
 
             // Build a satellite view for this tank and let the player
             // update the tank algorithm with the appropriate BattleInfo
-            MySatelliteView tank_view(board_, tank.x, tank.y, live_shells_);
+            MySatelliteView tank_view = createSatelliteViewForTank(ctx, tank);
             player1.updateTankWithBattleInfo(*tank_ai, tank_view);
             // Get action from AI
             ActionRequest action = tank_ai->getAction();
+            recordDecision(tank, action);
 
             if (verbose_) {
                 std::cout << "  Action: " << actionRequestToString(action) << std::endl;
             }
 
             // Execute the action!
-            bool success = executeAction(tank, action, map_width, map_height);
+            bool success = executeAction(ctx, tank, action);
 
             // Check if we need to mark any tank as dead from shell advancement
-            if (last_hit_player_ != 0) {
-                // Find and mark the hit tank as dead
-                if (last_hit_player_ == 1) {
-                    for (auto& t : player1_tanks) {
-                        if (t.x == last_hit_position_.first && t.y == last_hit_position_.second) {
-                            t.is_alive = false;
-                            if (verbose_) {
-                                std::cout << "    *** Player 1 Tank destroyed at (" << t.x << "," << t.y << ") ***" << std::endl;
-                            }
-                            break;
-                        }
-                    }
-                } else if (last_hit_player_ == 2) {
-                    for (auto& t : player2_tanks) {
-                        if (t.x == last_hit_position_.first && t.y == last_hit_position_.second) {
-                            t.is_alive = false;
-                            if (verbose_) {
-                                std::cout << "    *** Player 2 Tank destroyed at (" << t.x << "," << t.y << ") ***" << std::endl;
-                            }
-                            break;
-                        }
-                    }
-                }
-                // Reset hit tracking
-                last_hit_player_ = 0;
-            }
+            resolveLastHit(ctx, player1_tanks, player2_tanks);
 
             if (verbose_ && !success) {
                 std::cout << "    Action failed!" << std::endl;
@@ -197,7 +150,8 @@ GameResult GameManager_212934582_323964676::run(
         }
 
         // Execute player 2 turns
-        for (auto& tank : player2_tanks) {
+        for (size_t i = 0; i < player2_tanks.size(); ++i) {
+            TankState& tank = player2_tanks[i];
             if (!tank.is_alive) continue;  // Skip dead tanks
 
             if (verbose_) {
@@ -207,59 +161,38 @@ GameResult GameManager_212934582_323964676::run(
             }
 
             try {
-                // Create tank algorithm instance
-                auto tank_ai = player2_tank_algo_factory(tank.player_id, tank.tank_id);
+                // Create the tank's algorithm instance on its first turn
+                auto& tank_ai = player2_algos[i];
+                if (!tank_ai) {
+                    tank_ai = player2_tank_algo_factory(tank.player_id, tank.tank_id);
 
-                if (verbose_) {
-                    std::cout << "    Tank AI created successfully" << std::endl;
+                    if (verbose_) {
+                        std::cout << "    Tank AI created successfully" << std::endl;
+                    }
                 }
 
                 // Build a satellite view for this tank and let the player
                 // update the tank algorithm with the appropriate BattleInfo
-                MySatelliteView tank_view(board_, tank.x, tank.y, live_shells_);
+                MySatelliteView tank_view = createSatelliteViewForTank(ctx, tank);
                 player2.updateTankWithBattleInfo(*tank_ai, tank_view);
 
                 // Get action from AI
                 ActionRequest action = tank_ai->getAction();
+                recordDecision(tank, action);
 
                 if (verbose_) {
                     std::cout << "    Action: " << actionRequestToString(action) << std::endl;
                 }
 
                 // Execute the action!
-                bool success = executeAction(tank, action, map_width, map_height);
+                bool success = executeAction(ctx, tank, action);
 
                 // Check if we need to mark any tank as dead from shell advancement
-            if (last_hit_player_ != 0) {
-                // Find and mark the hit tank as dead
-                if (last_hit_player_ == 1) {
-                    for (auto& t : player1_tanks) {
-                        if (t.x == last_hit_position_.first && t.y == last_hit_position_.second) {
-                            t.is_alive = false;
-                            if (verbose_) {
-                                std::cout << "    *** Player 1 Tank destroyed at (" << t.x << "," << t.y << ") ***" << std::endl;
-                            }
-                            break;
-                        }
-                    }
-                } else if (last_hit_player_ == 2) {
-                    for (auto& t : player2_tanks) {
-                        if (t.x == last_hit_position_.first && t.y == last_hit_position_.second) {
-                            t.is_alive = false;
-                            if (verbose_) {
-                                std::cout << "    *** Player 2 Tank destroyed at (" << t.x << "," << t.y << ") ***" << std::endl;
-                            }
-                            break;
-                        }
-                    }
-                }
-                // Reset hit tracking
-                last_hit_player_ = 0;
-            }
+                resolveLastHit(ctx, player1_tanks, player2_tanks);
 
-            if (verbose_ && !success) {
-                std::cout << "    Action failed!" << std::endl;
-            }
+                if (verbose_ && !success) {
+                    std::cout << "    Action failed!" << std::endl;
+                }
 
             } catch (const std::exception& e) {
                 if (verbose_) {
@@ -332,8 +265,15 @@ GameResult GameManager_212934582_323964676::run(
     // Add the missing fields required by the new API
     result.rounds = current_step;
     
-    // Create a snapshot of the final game state
-    result.gameState = std::make_unique<MySatelliteView>(board_, 0, 0, live_shells_);
+    // Create a compact snapshot of the final game state (no tank highlighted),
+    // unless the caller said it does not need one
+    if (capture_final_state_) {
+        result.gameState = std::make_unique<PackedSatelliteView>(ctx.view.get());
+    }
+
+    if (!decision_record_.empty()) {
+        appendDecisions(decisions);
+    }
 
     if (verbose_) {
         std::cout << "\nGame completed after " << current_step << " steps" << std::endl;
@@ -348,17 +288,131 @@ GameResult GameManager_212934582_323964676::run(
     return result;
 }
 
+void GameManager_212934582_323964676::setBoardCell(GameContext& ctx, size_t row, size_t col, char c) {
+    ctx.board[row][col] = c;
+    ctx.move_masks.cellChanged(ctx.board, row, col);
+    refreshViewCell(ctx, row, col);
+}
+
+void GameManager_212934582_323964676::refreshViewCell(GameContext& ctx, size_t row, size_t col) {
+    char c = MySatelliteView::sanitize(ctx.board[row][col]);
+    for (const auto& shell : ctx.live_shells) {
+        if (shell.x == col && shell.y == row) {
+            c = '*';
+            break;
+        }
+    }
+    if (ctx.view.at(row, col) != c) {
+        ctx.view.set(row, col, c);  // copies the grid only if a snapshot of it is still held
+        ctx.journal.record(row, col, c);
+    }
+}
+
+void GameManager_212934582_323964676::advanceShells(GameContext& ctx) const {
+    if (verbose_) {
+        std::cout << "  Advancing " << ctx.live_shells.size() << " flying shells..." << std::endl;
+    }
+
+    std::pmr::vector<ShellState> still_flying(ctx.step_arena.resource());
+    std::pmr::vector<std::pair<size_t, size_t>> touched(ctx.step_arena.resource());  // cells whose '*' overlay may change
+    for (auto& shell : ctx.live_shells) {
+        touched.emplace_back(shell.y, shell.x);
+        // toVector returns (dRow, dCol)
+        auto [dRow, dCol] = DirectionUtils::toVector(static_cast<Direction>(shell.dir));
+        int new_x = static_cast<int>(shell.x) + dCol; // column += col delta
+        int new_y = static_cast<int>(shell.y) + dRow; // row    += row delta
+
+        // Check if shell goes out of bounds
+        if (new_x < 0 || new_y < 0 ||
+            static_cast<size_t>(new_x) >= ctx.width ||
+            static_cast<size_t>(new_y) >= ctx.height) {
+            if (verbose_) {
+                std::cout << "    Shell at (" << shell.x << "," << shell.y << ") goes out of bounds" << std::endl;
+            }
+            continue;  // Shell destroyed
+        }
+
+        // Check if shell hits a wall
+        if (ctx.board[new_y][new_x] == '#') {
+            if (verbose_) {
+                std::cout << "    Shell at (" << shell.x << "," << shell.y << ") hits wall at (" << new_x << "," << new_y << ")" << std::endl;
+            }
+            continue;  // Shell destroyed
+        }
+
+        // Check if shell hits a tank
+        char cell = ctx.board[new_y][new_x];
+        if (cell == '1' || cell == '2') {
+            if (verbose_) {
+                std::cout << "    Shell at (" << shell.x << "," << shell.y << ") hits tank '" << cell << "' at (" << new_x << "," << new_y << ")!" << std::endl;
+            }
+
+            // Clear the tank from board
+            setBoardCell(ctx, new_y, new_x, ' ');
+
+            // Store hit information for tank destruction
+            ctx.last_hit_position = std::make_pair(new_x, new_y);
+            ctx.last_hit_player = (cell == '1') ? 1 : 2;
+
+            continue;  // Shell destroyed
+        }
+
+        // Shell continues flying
+        shell.x = static_cast<size_t>(new_x);
+        shell.y = static_cast<size_t>(new_y);
+        still_flying.push_back(shell);
+        touched.emplace_back(shell.y, shell.x);
+
+        if (verbose_) {
+            std::cout << "    Shell advances to (" << shell.x << "," << shell.y << ")" << std::endl;
+        }
+    }
+
+    // Update live shells list
+    ctx.live_shells.assign(still_flying.begin(), still_flying.end());  // reuses live_shells' capacity
+    for (const auto& [row, col] : touched) {
+        refreshViewCell(ctx, row, col);
+    }
+
+    if (verbose_) {
+        std::cout << "  " << ctx.live_shells.size() << " shells still flying" << std::endl;
+    }
+}
+
+void GameManager_212934582_323964676::resolveLastHit(GameContext& ctx,
+                                                     std::vector<TankState>& player1_tanks,
+                                                     std::vector<TankState>& player2_tanks) const {
+    if (ctx.last_hit_player == 0) {
+        return;
+    }
+
+    // Find and mark the hit tank as dead
+    auto& hit_tanks = (ctx.last_hit_player == 1) ? player1_tanks : player2_tanks;
+    for (auto& t : hit_tanks) {
+        if (t.x == ctx.last_hit_position.first && t.y == ctx.last_hit_position.second) {
+            t.is_alive = false;
+            if (verbose_) {
+                std::cout << "    *** Player " << ctx.last_hit_player << " Tank destroyed at ("
+                          << t.x << "," << t.y << ") ***" << std::endl;
+            }
+            break;
+        }
+    }
+    // Reset hit tracking
+    ctx.last_hit_player = 0;
+}
+
 std::vector<TankState> GameManager_212934582_323964676::findTanks(
-    const SatelliteView& map, size_t width, size_t height, int player_id, size_t shells_per_tank) {
+    const GameContext& ctx, int player_id, size_t shells_per_tank) const {
 
     std::vector<TankState> tanks;
     char player_char = (player_id == 1) ? '1' : '2';  // Convert player_id to character
     int tank_counter = 0;  // Track tank index for each player
 
-    // Scan the entire map looking for the player character ('1' or '2')
-    for (size_t y = 0; y < height; ++y) {
-        for (size_t x = 0; x < width; ++x) {
-            char cell = map.getObjectAt(x, y);
+    // Scan the already-ingested board looking for the player character ('1' or '2')
+    for (size_t y = 0; y < ctx.height; ++y) {
+        for (size_t x = 0; x < ctx.width; ++x) {
+            char cell = ctx.board[y][x];
             if (cell == player_char) {
                 tanks.emplace_back(x, y, player_id, tank_counter++, shells_per_tank);
 
@@ -382,6 +436,19 @@ std::vector<TankState> GameManager_212934582_323964676::findTanks(
     return tanks;
 }
 
+void GameManager_212934582_323964676::appendDecisions(const std::vector<uint64_t>& decisions) const {
+    // One lock for every manager in the process: games on other threads may
+    // record to the same file
+    static std::mutex record_mutex;
+    std::lock_guard<std::mutex> lock(record_mutex);
+    std::ofstream out(decision_record_, std::ios::binary | std::ios::app);
+    out.write(reinterpret_cast<const char*>(decisions.data()),
+              static_cast<std::streamsize>(decisions.size() * sizeof(uint64_t)));
+    if (!out && verbose_) {
+        std::cout << "Could not record decisions to " << decision_record_ << std::endl;
+    }
+}
+
 std::string GameManager_212934582_323964676::actionRequestToString(ActionRequest req) {
     switch (req) {
         case ActionRequest::MoveForward:   return "MoveForward";
@@ -397,13 +464,16 @@ std::string GameManager_212934582_323964676::actionRequestToString(ActionRequest
     return "Unknown";
 }
 
-MySatelliteView GameManager_212934582_323964676::createSatelliteViewForTank(const TankState& tank) const {
+MySatelliteView GameManager_212934582_323964676::createSatelliteViewForTank(const GameContext& ctx, const TankState& tank) const {
     // Create a MySatelliteView that shows the tank's position as '%'
-    // and includes all flying shells as '*'
-    return MySatelliteView(board_, tank.x, tank.y, live_shells_);
+    // over the shared view grid (which already holds flying shells as '*'),
+    // able to report what changed since a tank's previous view
+    return MySatelliteView(ctx.view.snapshot(), tank.x, tank.y, &ctx.journal);
 }
 
-MyBattleInfo GameManager_212934582_323964676::createBattleInfoForTank(const TankState& tank, size_t width, size_t height) const {
+MyBattleInfo GameManager_212934582_323964676::createBattleInfoForTank(const GameContext& ctx, const TankState& tank) const {
+    const size_t width = ctx.width;
+    const size_t height = ctx.height;
     // Create a MyBattleInfo with all the information this tank needs
     // Make sure dimensions are reasonable to avoid huge memory allocations
     if (width > 1000 || height > 1000) {
@@ -418,7 +488,7 @@ MyBattleInfo GameManager_212934582_323964676::createBattleInfoForTank(const Tank
     return MyBattleInfo(
         height,                    // rows (map height)
         width,                     // cols (map width)
-        board_,                    // board (copy of the game board)
+        ctx.view.snapshot(),       // board (shared, not copied)
         tank.y,                    // x = row
         tank.x,                    // y = column
         tank.facing,               // direction (tank's current facing)
@@ -426,7 +496,7 @@ MyBattleInfo GameManager_212934582_323964676::createBattleInfoForTank(const Tank
     );
 }
 
-bool GameManager_212934582_323964676::executeAction(TankState& tank, ActionRequest action, size_t map_width, size_t map_height) {
+bool GameManager_212934582_323964676::executeAction(GameContext& ctx, TankState& tank, ActionRequest action) const {
     if (!tank.is_alive) {
         return false;  // Dead tanks can't act
     }
@@ -480,10 +550,10 @@ bool GameManager_212934582_323964676::executeAction(TankState& tank, ActionReque
 
         case ActionRequest::MoveForward:
         case ActionRequest::MoveBackward:
-            return executeMovement(tank, action, map_width, map_height);
+            return executeMovement(ctx, tank, action);
 
         case ActionRequest::Shoot:
-            return executeShoot(tank, map_width, map_height);
+            return executeShoot(ctx, tank);
 
         default:
             if (verbose_) {
@@ -493,7 +563,7 @@ bool GameManager_212934582_323964676::executeAction(TankState& tank, ActionReque
     }
 }
 
-bool GameManager_212934582_323964676::executeMovement(TankState& tank, ActionRequest action, size_t map_width, size_t map_height) {
+bool GameManager_212934582_323964676::executeMovement(GameContext& ctx, TankState& tank, ActionRequest action) const {
     if (!tank.is_alive) {
         return false;
     }
@@ -513,42 +583,20 @@ bool GameManager_212934582_323964676::executeMovement(TankState& tank, ActionReq
     int new_x = static_cast<int>(tank.x) + dCol;  // column += colDelta
     int new_y = static_cast<int>(tank.y) + dRow;  // row    += rowDelta
 
-    // Check boundaries
-    if (new_x < 0 || new_y < 0 ||
-        static_cast<size_t>(new_x) >= map_width ||
-        static_cast<size_t>(new_y) >= map_height) {
-        if (verbose_) {
-            std::cout << "    Movement blocked: would go out of bounds ("
-                      << new_x << "," << new_y << ")" << std::endl;
-        }
-        return false;
-    }
-
-    // Check collision with walls and obstacles
-    // Safety check: ensure the row exists and has data
-    if (static_cast<size_t>(new_y) >= board_.size() ||
-           board_[static_cast<size_t>(new_y)].empty() ||
-           static_cast<size_t>(new_x) >= board_[static_cast<size_t>(new_y)].length()) {
-        if (verbose_) {
-            std::cout << "    Movement blocked: invalid board position (" << new_x << "," << new_y << ")" << std::endl;
-        }
-        return false;
-    }
-
-    char target_cell = board_[new_y][new_x];  // board_[row][col] = board_[y][x]
-    if (target_cell == '#' || target_cell == '@') {
+    // One lookup in the legal-move mask replaces the bounds/obstacle/tank tests
+    if (!ctx.move_masks.canMove(tank.y, tank.x, static_cast<Direction>(move_direction))) {
         if (verbose_) {
-            std::cout << "    Movement blocked: obstacle '" << target_cell
-                      << "' at (" << new_x << "," << new_y << ")" << std::endl;
-        }
-        return false;
-    }
-
-    // Check collision with other tanks (basic version - tank characters '1' or '2')
-    if (target_cell == '1' || target_cell == '2') {
-        if (verbose_) {
-            std::cout << "    Movement blocked: tank '" << target_cell
-                      << "' at (" << new_x << "," << new_y << ")" << std::endl;
+            if (new_x < 0 || new_y < 0 ||
+                static_cast<size_t>(new_x) >= ctx.width ||
+                static_cast<size_t>(new_y) >= ctx.height) {
+                std::cout << "    Movement blocked: would go out of bounds ("
+                          << new_x << "," << new_y << ")" << std::endl;
+            } else {
+                char target_cell = ctx.board[new_y][new_x];  // board[row][col] = board[y][x]
+                std::cout << "    Movement blocked: "
+                          << ((target_cell == '1' || target_cell == '2') ? "tank '" : "obstacle '")
+                          << target_cell << "' at (" << new_x << "," << new_y << ")" << std::endl;
+            }
         }
         return false;
     }
@@ -563,37 +611,37 @@ bool GameManager_212934582_323964676::executeMovement(TankState& tank, ActionReq
     char tank_char = (tank.player_id == 1) ? '1' : '2';
 
     // Safety check: ensure old position is valid
-    if (tank.y < board_.size() && !board_[tank.y].empty() && tank.x < board_[tank.y].length()) {
-        board_[tank.y][tank.x] = ' ';  // Clear old position
+    if (tank.y < ctx.board.size() && !ctx.board[tank.y].empty() && tank.x < ctx.board[tank.y].length()) {
+        setBoardCell(ctx, tank.y, tank.x, ' ');  // Clear old position
     }
 
     tank.x = static_cast<size_t>(new_x);
     tank.y = static_cast<size_t>(new_y);
 
     // Safety check: ensure new position is valid
-    if (tank.y < board_.size() && !board_[tank.y].empty() && tank.x < board_[tank.y].length()) {
-        board_[tank.y][tank.x] = tank_char;  // Set new position
+    if (tank.y < ctx.board.size() && !ctx.board[tank.y].empty() && tank.x < ctx.board[tank.y].length()) {
+        setBoardCell(ctx, tank.y, tank.x, tank_char);  // Set new position
     }
 
     return true;
 }
 
 // Helper function to check if tank can shoot an enemy from current position and direction (HW2 logic)
-bool GameManager_212934582_323964676::canShootFrom(size_t x, size_t y, int facing, int player_id) const {
-    // toVector returns (dRow, dCol). Our board indexing is board_[row][col] => [y][x].
+bool GameManager_212934582_323964676::canShootFrom(const GameContext& ctx, size_t x, size_t y, int facing, int player_id) const {
+    // toVector returns (dRow, dCol). Our board indexing is ctx.board[row][col] => [y][x].
     auto [dRow, dCol] = DirectionUtils::toVector(static_cast<Direction>(facing));
 
     // Ray-cast in the direction the tank is facing
     for (int rx = static_cast<int>(x) + dCol, ry = static_cast<int>(y) + dRow;
-         rx >= 0 && ry >= 0 && static_cast<size_t>(rx) < board_[0].size() && static_cast<size_t>(ry) < board_.size();
+         rx >= 0 && ry >= 0 && static_cast<size_t>(rx) < ctx.board[0].size() && static_cast<size_t>(ry) < ctx.board.size();
          rx += dCol, ry += dRow)
     {
         // Safety check: ensure the row exists and has data
-        if (static_cast<size_t>(ry) >= board_.size() || board_[ry].empty() || static_cast<size_t>(rx) >= board_[ry].length()) {
+        if (static_cast<size_t>(ry) >= ctx.board.size() || ctx.board[ry].empty() || static_cast<size_t>(rx) >= ctx.board[ry].length()) {
             break;  // Out of bounds or empty row
         }
 
-        char ch = board_[ry][rx];
+        char ch = ctx.board[ry][rx];
         if (ch == '#' || ch == '@') {
             // blocked by wall/mine
             return false;
@@ -612,7 +660,7 @@ bool GameManager_212934582_323964676::canShootFrom(size_t x, size_t y, int facin
     return false;  // No enemy found in this direction
 }
 
-bool GameManager_212934582_323964676::executeShoot(TankState& tank, size_t map_width, size_t map_height) {
+bool GameManager_212934582_323964676::executeShoot(GameContext& ctx, TankState& tank) const {
     if (!tank.is_alive) {
         return false;
     }
@@ -626,7 +674,7 @@ bool GameManager_212934582_323964676::executeShoot(TankState& tank, size_t map_w
     }
 
     // Check if tank can actually hit an enemy from current position and direction (HW2 validation)
-    if (!canShootFrom(tank.x, tank.y, tank.facing, tank.player_id)) {
+    if (!canShootFrom(ctx, tank.x, tank.y, tank.facing, tank.player_id)) {
         if (verbose_) {
             std::cout << "    Shooting failed: no enemy in line of sight from position ("
                       << tank.x << "," << tank.y << ") facing direction " << static_cast<int>(tank.facing) << std::endl;
@@ -648,10 +696,10 @@ bool GameManager_212934582_323964676::executeShoot(TankState& tank, size_t map_w
 
     // Ray-cast until wall or out-of-bounds (HW2 logic)
     for (int rx = static_cast<int>(tank.x) + dCol, ry = static_cast<int>(tank.y) + dRow;
-         rx >= 0 && ry >= 0 && static_cast<size_t>(rx) < map_width && static_cast<size_t>(ry) < map_height;
+         rx >= 0 && ry >= 0 && static_cast<size_t>(rx) < ctx.width && static_cast<size_t>(ry) < ctx.height;
          rx += dCol, ry += dRow)
     {
-        char cell = board_[ry][rx];
+        char cell = ctx.board[ry][rx];
         if (cell == '#') {
             // Hit wall, stop ray-casting
             break;
@@ -666,9 +714,9 @@ bool GameManager_212934582_323964676::executeShoot(TankState& tank, size_t map_w
                     std::cout << "      Shell immediately hits tank '" << cell
                               << "' at (" << rx << "," << ry << ")!" << std::endl;
                 }
-                board_[ry][rx] = ' ';
-                last_hit_position_ = std::make_pair(rx, ry);
-                last_hit_player_ = hit_player;
+                setBoardCell(ctx, ry, rx, ' ');
+                ctx.last_hit_position = std::make_pair(rx, ry);
+                ctx.last_hit_player = hit_player;
                 return true;  // Tank killed, shell consumed
             } else {
                 // Hit our own tank, stop ray-casting
@@ -7,6 +7,11 @@
 #include "../common/TankAlgorithm.h"
 #include "../common/SatelliteView.h"
 #include "../UserCommon/MyBattleInfo_212934582_323964676.h"  // Include the full MyBattleInfo definition
+#include "../UserCommon/MoveMask_212934582_323964676.h"
+#include "../UserCommon/SharedGrid_212934582_323964676.h"
+#include "../UserCommon/ChangeJournal_212934582_323964676.h"
+#include "../UserCommon/StepArena_212934582_323964676.h"
+#include "../UserCommon/GameManagerOptions_212934582_323964676.h"
 #include <memory>
 #include <vector>
 #include <array>
@@ -16,6 +21,12 @@ namespace GameManager_212934582_323964676 {
 
 // Import UserCommon types
 using UserCommon_212934582_323964676::MyBattleInfo;
+using UserCommon_212934582_323964676::MoveMaskGrid;
+using UserCommon_212934582_323964676::SharedGrid;
+using UserCommon_212934582_323964676::GridSnapshot;
+using UserCommon_212934582_323964676::ChangeJournal;
+using UserCommon_212934582_323964676::CellChange;
+using UserCommon_212934582_323964676::StepArena;
 
 // Forward declarations
 class MySatelliteView;
@@ -45,7 +56,30 @@ struct ShellState {
     ShellState(size_t x, size_t y, int dir) : x(x), y(y), dir(dir) {}
 };
 
-class GameManager_212934582_323964676 : public AbstractGameManager {
+// Everything that changes while a single game is played. run() keeps one of
+// these on its own stack, so the manager instance itself holds no per-game
+// state and a single instance can serve several games concurrently.
+struct GameContext {
+    size_t width;                           // Map width (columns)
+    size_t height;                          // Map height (rows)
+    std::vector<std::string> board;         // The live map as strings, board[row][col]
+    std::vector<ShellState> live_shells;    // All shells currently in flight
+    MoveMaskGrid move_masks;                // Legal-move bits per cell, kept in sync with board
+    SharedGrid view;                        // The board as players see it (sanitised, '*' for shells),
+                                            // shared by every view and battle info handed out
+    ChangeJournal journal;                  // Every change made to view, for players that repair from it
+    StepArena step_arena;                   // Scratch memory for one game step, reset as each step begins
+
+    // Tank destruction tracking
+    std::pair<size_t, size_t> last_hit_position;
+    int last_hit_player;
+
+    GameContext(size_t width, size_t height)
+        : width(width), height(height), last_hit_position(0, 0), last_hit_player(0) {}
+};
+
+class GameManager_212934582_323964676 : public AbstractGameManager,
+                                        public UserCommon_212934582_323964676::GameManagerOptions {
 public:
     GameManager_212934582_323964676(bool verbose);
     virtual ~GameManager_212934582_323964676() = default;
@@ -53,6 +87,7 @@ public:
     // AbstractGameManager interface
     // Note: Simulator provides map as SatelliteView and owns Player objects
     // GameManager receives references and does NOT read files or own Players
+    // run() is re-entrant: all per-game state lives in a GameContext local to the call
     virtual GameResult run(
         size_t map_width,
         size_t map_height,
@@ -67,41 +102,51 @@ public:
         TankAlgorithmFactory player1_tank_algo_factory,
         TankAlgorithmFactory player2_tank_algo_factory) override;
 
+    // GameManagerOptions interface
+    void setCaptureFinalState(bool capture) override { capture_final_state_ = capture; }
+    void setDecisionRecord(const std::string& path) override { decision_record_ = path; }
+
 private:
-    bool verbose_;
-    
-    // Game state (adapted from HW2)
-    std::vector<std::string> board_;        // The static map as strings
-    std::vector<ShellState> live_shells_;   // All shells currently in flight
-    
-    // Tank destruction tracking
-    std::pair<size_t, size_t> last_hit_position_;
-    int last_hit_player_;
+    const bool verbose_;
+    bool capture_final_state_ = true;   // Fill GameResult::gameState (set before running games)
+    std::string decision_record_;       // File the decisions of every game are appended to, if any
     
     // Helper functions (adapted from HW2)
-    std::vector<TankState> findTanks(const SatelliteView& map, size_t width, size_t height, int player_id, size_t shells_per_tank);
-    std::string actionRequestToString(ActionRequest req);
+    std::vector<TankState> findTanks(const GameContext& ctx, int player_id, size_t shells_per_tank) const;
+    static std::string actionRequestToString(ActionRequest req);
+
+    // Append one game's decisions to decision_record_; games on other threads wait their turn
+    void appendDecisions(const std::vector<uint64_t>& decisions) const;
     
     // Create a MySatelliteView for a specific tank
-    MySatelliteView createSatelliteViewForTank(const TankState& tank) const;
+    MySatelliteView createSatelliteViewForTank(const GameContext& ctx, const TankState& tank) const;
     
     // Create a MyBattleInfo for a specific tank
-    MyBattleInfo createBattleInfoForTank(const TankState& tank, size_t width, size_t height) const;
+    MyBattleInfo createBattleInfoForTank(const GameContext& ctx, const TankState& tank) const;
+
+    // Write one board cell and keep move_masks and view in sync with it
+    static void setBoardCell(GameContext& ctx, size_t row, size_t col, char c);
+
+    // Recompute view[row][col] from the board and the shells in flight, journaling any change
+    static void refreshViewCell(GameContext& ctx, size_t row, size_t col);
+
+    // Advance every shell in flight by one cell, resolving wall and tank hits
+    void advanceShells(GameContext& ctx) const;
+
+    // Mark the tank recorded in ctx.last_hit_* (if any) as dead and reset the tracking
+    void resolveLastHit(GameContext& ctx, std::vector<TankState>& player1_tanks, std::vector<TankState>& player2_tanks) const;
     
     // Execute a tank action (adapted from HW2)
-    bool executeAction(TankState& tank, ActionRequest action, size_t map_width, size_t map_height);
+    bool executeAction(GameContext& ctx, TankState& tank, ActionRequest action) const;
     
     // Execute movement with collision detection
-    bool executeMovement(TankState& tank, ActionRequest action, size_t map_width, size_t map_height);
+    bool executeMovement(GameContext& ctx, TankState& tank, ActionRequest action) const;
     
     // Execute shooting with ray-casting (adapted from HW2)
-    bool executeShoot(TankState& tank, size_t map_width, size_t map_height);
+    bool executeShoot(GameContext& ctx, TankState& tank) const;
     
     // Helper function to check if tank can shoot an enemy (HW2 ray-casting logic)
-    bool canShootFrom(size_t x, size_t y, int facing, int player_id) const;
-    
-    // Helper to find and kill tank at position
-    bool killTankAt(size_t x, size_t y, std::vector<TankState>& player1_tanks, std::vector<TankState>& player2_tanks);
+    bool canShootFrom(const GameContext& ctx, size_t x, size_t y, int facing, int player_id) const;
 };
 
 } // namespace GameManager_212934582_323964676
@@ -3,52 +3,46 @@
 #define MYSATELLITEVIEW_H
 
 #include "../common/SatelliteView.h"
+#include "../UserCommon/BulkSatelliteView_212934582_323964676.h"
 #include "GameManager_212934582_323964676.h"
 #include <vector>
-#include <set>
 #include <utility>
 #include <cstddef>
+#include <cstring>
+#include <algorithm>
 
 namespace GameManager_212934582_323964676 {
 
-class MySatelliteView : public SatelliteView {
+// Read-only view over a shared grid (see GameContext::view) that already holds
+// sanitised board characters and '*' for flying shells. Building one per tank
+// only bumps a reference count; the grid itself is never copied.
+class MySatelliteView : public UserCommon_212934582_323964676::BulkSatelliteView {
 public:
-    // Base constructor that takes (board, liveShells) with no highlight
-    MySatelliteView(const std::vector<std::string>& board,
-                    const std::vector<ShellState>& liveShells)
-      : board_(board)
-      , highlight_x_(static_cast<size_t>(-1))
-      , highlight_y_(static_cast<size_t>(-1))
-    {
-        for (const auto& shell : liveShells) {
-            shells_.insert({ shell.x, shell.y });
-        }
-    }
+    static constexpr size_t NO_HIGHLIGHT = static_cast<size_t>(-1);
 
-    // Constructor with highlight position
-    MySatelliteView(const MySatelliteView& other,
-                    size_t highlight_x,
-                    size_t highlight_y)
-      : board_(other.board_)
-      , shells_(other.shells_)
+    // Constructor: shared grid + optional highlight position + optional journal of
+    // the changes that led to the grid (must outlive the view)
+    explicit MySatelliteView(GridSnapshot grid,
+                             size_t highlight_x = NO_HIGHLIGHT,
+                             size_t highlight_y = NO_HIGHLIGHT,
+                             const ChangeJournal* journal = nullptr)
+      : grid_(std::move(grid))
       , highlight_x_(highlight_x)
       , highlight_y_(highlight_y)
+      , journal_(journal)
+      , sequence_(journal ? journal->sequence() : 0)
     {}
 
-    // Constructor: board + highlight + list of live shells
-    MySatelliteView(const std::vector<std::string>& board,
+    // Constructor with highlight position
+    MySatelliteView(const MySatelliteView& other,
                     size_t highlight_x,
-                    size_t highlight_y,
-                    const std::vector<ShellState>& liveShells)
-      : board_(board)
+                    size_t highlight_y)
+      : grid_(other.grid_)
       , highlight_x_(highlight_x)
       , highlight_y_(highlight_y)
-    {
-        // Populate shells from the vector<ShellState>
-        for (const auto& shell : liveShells) {
-            shells_.insert({ shell.x, shell.y });
-        }
-    }
+      , journal_(other.journal_)
+      , sequence_(other.sequence_)
+    {}
 
     // Produce a copy of this view but marking (x,y) as '%'
     MySatelliteView withHighlight(size_t x, size_t y) const {
@@ -57,8 +51,9 @@ public:
 
     // SatelliteView interface implementation
     [[nodiscard]] char getObjectAt(size_t xCoord, size_t yCoord) const override {
-        // 1) Outside board boundaries - board_[row][col], where row=y, col=x
-        if (board_.empty() || yCoord >= board_.size() || board_[0].empty() || xCoord >= board_[0].size()) {
+        // 1) Outside board boundaries - grid[row][col], where row=y, col=x
+        auto [width, height] = dimensions();
+        if (yCoord >= height || xCoord >= width) {
             return '&';
         }
 
@@ -67,24 +62,61 @@ public:
             return '%';
         }
 
-        // 3) If a shell is flying over (x,y) marked as '*'
-        if (shells_.count({xCoord, yCoord})) {
-            return '*';
+        // 3) Otherwise the shared grid already holds the board character or '*' for a shell
+        return (*grid_)[yCoord][xCoord];
+    }
+
+    // BulkSatelliteView interface implementation
+    std::pair<size_t, size_t> dimensions() const override {
+        if (!grid_ || grid_->empty() || (*grid_)[0].empty()) {
+            return { 0, 0 };
+        }
+        return { (*grid_)[0].size(), grid_->size() };
+    }
+
+    // Same characters getObjectAt() would return, one memcpy per row
+    void copyRow(size_t yCoord, size_t xCoord, size_t count, char* out) const override {
+        auto [width, height] = dimensions();
+        if (yCoord >= height || xCoord >= width) {
+            std::memset(out, '&', count);
+            return;
+        }
+        size_t inside = std::min(count, width - xCoord);
+        std::memcpy(out, (*grid_)[yCoord].data() + xCoord, inside);
+        std::memset(out + inside, '&', count - inside);
+        if (highlight_y_ == yCoord && highlight_x_ >= xCoord && highlight_x_ < xCoord + inside) {
+            out[highlight_x_ - xCoord] = '%';
         }
+    }
 
-        // 4) Otherwise return the static board character - board_[row][col] = board_[y][x]
-        char c = board_[yCoord][xCoord];
-        if (c == '#' || c == '@' || c == '1' || c == '2' || c == ' ') {
-            return c;
+    GridSnapshot snapshot() const override { return grid_; }
+
+    bool selfPosition(size_t& x, size_t& y) const override {
+        if (highlight_x_ == NO_HIGHLIGHT) {
+            return false;
         }
-        return ' ';  // Unknown characters become empty space
+        x = highlight_x_;
+        y = highlight_y_;
+        return true;
+    }
+
+    uint64_t sequence() const override { return sequence_; }
+
+    bool changesSince(uint64_t since, std::pmr::vector<CellChange>& out) const override {
+        return journal_ && journal_->changesBetween(since, sequence_, out);
+    }
+
+    // Characters a player may see; anything else becomes empty space
+    static char sanitize(char c) {
+        return (c == '#' || c == '@' || c == '1' || c == '2') ? c : ' ';
     }
 
 private:
-    std::vector<std::string> board_;                    // The static game board
-    std::set<std::pair<size_t, size_t>> shells_;        // Positions of flying shells
+    GridSnapshot grid_;                                 // Shared game board as players see it
     size_t highlight_x_;                                // This tank's X position (marked as '%')
     size_t highlight_y_;                                // This tank's Y position (marked as '%')
+    const ChangeJournal* journal_;                      // Changes behind grid_, or nullptr
+    uint64_t sequence_;                                 // Journal position grid_ corresponds to
 };
 
 } // namespace GameManager_212934582_323964676
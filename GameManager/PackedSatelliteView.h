@@ -0,0 +1,133 @@
+// PackedSatelliteView.h - Compact final-state snapshot for GameResult
+#ifndef PACKEDSATELLITEVIEW_H
+#define PACKEDSATELLITEVIEW_H
+
+#include "../common/SatelliteView.h"
+#include "../UserCommon/BulkSatelliteView_212934582_323964676.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace GameManager_212934582_323964676 {
+
+// Two bits per cell, four cells per byte, row after row
+class PackedLayer {
+public:
+    PackedLayer(size_t width, size_t height)
+      : width_(width), height_(height), bits_((width * height + 3) / 4, 0) {}
+
+    uint8_t get(size_t x, size_t y) const {
+        size_t i = y * width_ + x;
+        return (bits_[i / 4] >> ((i % 4) * 2)) & 3u;
+    }
+
+    void set(size_t x, size_t y, uint8_t code) {
+        size_t i = y * width_ + x;
+        bits_[i / 4] = static_cast<uint8_t>((bits_[i / 4] & ~(3u << ((i % 4) * 2))) | (code << ((i % 4) * 2)));
+    }
+
+    size_t width() const { return width_; }
+    size_t height() const { return height_; }
+
+    bool operator==(const PackedLayer& other) const {
+        return width_ == other.width_ && height_ == other.height_ && bits_ == other.bits_;
+    }
+
+    // FNV-1a over the packed bytes and the size
+    uint64_t hash() const {
+        uint64_t h = 1469598103934665603ULL;
+        auto mix = [&h](uint64_t v) { h ^= v; h *= 1099511628211ULL; };
+        mix(width_);
+        mix(height_);
+        for (uint8_t b : bits_) {
+            mix(b);
+        }
+        return h;
+    }
+
+private:
+    size_t width_, height_;
+    std::vector<uint8_t> bits_;
+};
+
+// Read-only final board: a static layer (walls and mines) shared by every game
+// played on the same map, plus a per-game layer for tanks and shells. A large
+// map costs a quarter byte per cell per game instead of a full board copy.
+class PackedSatelliteView : public UserCommon_212934582_323964676::BulkSatelliteView {
+public:
+    // Pack a board as players see it (board[row][col]: ' ', '#', '@', '1', '2' or '*')
+    explicit PackedSatelliteView(const std::vector<std::string>& board)
+      : dynamic_(board.empty() ? 0 : board[0].size(), board.size())
+    {
+        PackedLayer walls(dynamic_.width(), dynamic_.height());
+        for (size_t y = 0; y < dynamic_.height(); ++y) {
+            for (size_t x = 0; x < dynamic_.width(); ++x) {
+                char c = board[y][x];
+                walls.set(x, y, staticCode(c));
+                dynamic_.set(x, y, dynamicCode(c));
+            }
+        }
+        static_ = intern(std::move(walls));
+    }
+
+    [[nodiscard]] char getObjectAt(size_t x, size_t y) const override {
+        if (x >= dynamic_.width() || y >= dynamic_.height()) {
+            return '&';
+        }
+        uint8_t code = dynamic_.get(x, y);
+        return code ? DYNAMIC_CHARS[code] : STATIC_CHARS[static_->get(x, y)];
+    }
+
+    std::pair<size_t, size_t> dimensions() const override {
+        return { dynamic_.width(), dynamic_.height() };
+    }
+
+    void copyRow(size_t y, size_t x, size_t count, char* out) const override {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = getObjectAt(x + i, y);
+        }
+    }
+
+private:
+    static constexpr char STATIC_CHARS[4]  = { ' ', '#', '@', ' ' };
+    static constexpr char DYNAMIC_CHARS[4] = { ' ', '1', '2', '*' };
+
+    static uint8_t staticCode(char c) { return c == '#' ? 1 : c == '@' ? 2 : 0; }
+    static uint8_t dynamicCode(char c) { return c == '1' ? 1 : c == '2' ? 2 : c == '*' ? 3 : 0; }
+
+    // One shared copy of each distinct static layer for as long as any snapshot uses it
+    static std::shared_ptr<const PackedLayer> intern(PackedLayer layer) {
+        static std::mutex mutex;
+        static std::unordered_multimap<uint64_t, std::weak_ptr<const PackedLayer>> cache;
+
+        uint64_t key = layer.hash();
+        std::lock_guard<std::mutex> lock(mutex);
+        auto range = cache.equal_range(key);
+        for (auto it = range.first; it != range.second; ) {
+            if (auto shared = it->second.lock()) {
+                if (*shared == layer) {
+                    return shared;
+                }
+                ++it;
+            } else {
+                it = cache.erase(it);  // every snapshot of that map is gone
+            }
+        }
+        auto shared = std::make_shared<const PackedLayer>(std::move(layer));
+        cache.emplace(key, shared);
+        return shared;
+    }
+
+    std::shared_ptr<const PackedLayer> static_;    // Walls and mines, shared per map
+    PackedLayer dynamic_;                           // Tanks and shells of this game
+};
+
+} // namespace GameManager_212934582_323964676
+
+#endif // PACKEDSATELLITEVIEW_H
@@ -1,6 +1,7 @@
 #include "AlgorithmRegistrar.h"
 
 AlgorithmRegistrar AlgorithmRegistrar::singleton_;
+thread_local AlgorithmRegistrar::AlgorithmAndPlayerFactories* AlgorithmRegistrar::current_ = nullptr;
 
 AlgorithmRegistrar& AlgorithmRegistrar::get() {
     return singleton_;
@@ -1,14 +1,21 @@
 #pragma once
 #include <vector>
+#include <deque>
 #include <string>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <cassert>
 #include "../common/TankAlgorithm.h"
 #include "../common/Player.h"
 
-// Holds (PlayerFactory, TankAlgorithmFactory) for ONE algorithm .so
+// Holds (PlayerFactory, TankAlgorithmFactory) for every algorithm .so loaded.
+// A library registers from its static initialisers, which run inside dlopen on
+// the loading thread, into the entry that thread made current with a
+// LoadContext; so libraries can be loaded on several threads at once. An entry
+// is added once its library validated, and never changes after that.
 class AlgorithmRegistrar {
+public:
     class AlgorithmAndPlayerFactories {
         std::string so_name_;
         TankAlgorithmFactory tankAlgorithmFactory_;
@@ -40,10 +47,6 @@ class AlgorithmRegistrar {
         }
     };
 
-    std::vector<AlgorithmAndPlayerFactories> algorithms_;
-    static AlgorithmRegistrar singleton_;
-
-public:
     struct BadRegistrationException {
         std::string name;
         bool hasName;
@@ -51,40 +54,63 @@ public:
         bool hasTankAlgorithmFactory;
     };
 
+    // While alive, what libraries register on this thread goes to `entry`:
+    // construct it right before dlopen(dylib) for an algorithm .so
+    class LoadContext {
+        AlgorithmAndPlayerFactories* previous_;
+    public:
+        explicit LoadContext(AlgorithmAndPlayerFactories& entry) : previous_(current_) { current_ = &entry; }
+        ~LoadContext() { current_ = previous_; }
+        LoadContext(const LoadContext&) = delete;
+        LoadContext& operator=(const LoadContext&) = delete;
+    };
+
     static AlgorithmRegistrar& get();
     static AlgorithmRegistrar& getAlgorithmRegistrar() { return get(); }
 
-    // Called BEFORE dlopen(dylib) for this algorithm .so:
-    void createAlgorithmFactoryEntry(const std::string& so_base_name) {
-        algorithms_.emplace_back(so_base_name);
+    // Called by PlayerRegistration/TankAlgorithmRegistration (from inside the .so);
+    // ignored outside a LoadContext
+    static void addPlayerFactory(PlayerFactory&& factory) {
+        if (current_) current_->setPlayerFactory(std::move(factory));
     }
-
-    // Called by PlayerRegistration/TankAlgorithmRegistration (from inside the .so)
-    void addPlayerFactoryToLastEntry(PlayerFactory&& factory) {
-        algorithms_.back().setPlayerFactory(std::move(factory));
-    }
-    void addTankAlgorithmFactoryToLastEntry(TankAlgorithmFactory&& factory) {
-        algorithms_.back().setTankAlgorithmFactory(std::move(factory));
+    static void addTankAlgorithmFactory(TankAlgorithmFactory&& factory) {
+        if (current_) current_->setTankAlgorithmFactory(std::move(factory));
     }
 
-    // Validate AFTER dlopen (and remove on failure)
-    void validateLastRegistration() {
-        const auto& last = algorithms_.back();
-        bool hasName = !last.name().empty();
-        if (!hasName || !last.hasPlayerFactory() || !last.hasTankAlgorithmFactory()) {
+    // Validate AFTER dlopen
+    static void validate(const AlgorithmAndPlayerFactories& entry) {
+        bool hasName = !entry.name().empty();
+        if (!hasName || !entry.hasPlayerFactory() || !entry.hasTankAlgorithmFactory()) {
             throw BadRegistrationException{
-                .name = last.name(),
+                .name = entry.name(),
                 .hasName = hasName,
-                .hasPlayerFactory = last.hasPlayerFactory(),
-                .hasTankAlgorithmFactory = last.hasTankAlgorithmFactory()
+                .hasPlayerFactory = entry.hasPlayerFactory(),
+                .hasTankAlgorithmFactory = entry.hasTankAlgorithmFactory()
             };
         }
     }
-    void removeLast() { algorithms_.pop_back(); }
 
-    // Iteration
+    // Keep a validated entry, from any thread; it stays at the returned address
+    const AlgorithmAndPlayerFactories& add(AlgorithmAndPlayerFactories&& entry) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return algorithms_.emplace_back(std::move(entry));
+    }
+
+    // Iteration, once no library is being loaded
     auto begin() const { return algorithms_.begin(); }
     auto end()   const { return algorithms_.end();   }
     std::size_t count() const { return algorithms_.size(); }
-    void clear() { algorithms_.clear(); }
+
+    // Drop every entry; their factories run library code when destroyed, so
+    // before the libraries are closed
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        algorithms_.clear();
+    }
+
+private:
+    std::deque<AlgorithmAndPlayerFactories> algorithms_;
+    std::mutex mutex_;
+    static thread_local AlgorithmAndPlayerFactories* current_;
+    static AlgorithmRegistrar singleton_;
 };
@@ -0,0 +1,69 @@
+#include "CostModel.h"
+
+#include <algorithm>
+
+double CostModel::mapCost(const DecodedMap &map) {
+    return static_cast<double>(map.width) * static_cast<double>(map.height) *
+           static_cast<double>(std::max<size_t>(map.max_steps, 1)) *
+           static_cast<double>(std::max<size_t>(map.tanks, 1));
+}
+
+std::vector<double> CostModel::relativeRates(const std::vector<Rate> &rates) const {
+    std::vector<double> relative(rates.size(), 0.0);
+    for (size_t i = 0; i < rates.size(); ++i) {
+        if (rates[i].cost > 0) {
+            relative[i] = (rates[i].ms / rates[i].cost) / (total_.ms / total_.cost);
+        }
+    }
+    return relative;
+}
+
+CostModel::Snapshot CostModel::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Snapshot snapshot;
+    snapshot.games_ = games_;
+    if (total_.cost > 0 && total_.ms > 0) {
+        snapshot.observed_ = true;
+        snapshot.gameManagers_ = relativeRates(gameManagers_);
+        snapshot.algorithms_ = relativeRates(algorithms_);
+    }
+    return snapshot;
+}
+
+size_t CostModel::games() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return games_;
+}
+
+double CostModel::Snapshot::rate(const std::vector<double> &rates, size_t index) {
+    if (index >= rates.size() || rates[index] <= 0) {
+        return 1;  // not seen yet: as fast as the average
+    }
+    return rates[index];
+}
+
+double CostModel::Snapshot::estimate(double cost, size_t game_manager, size_t algorithm1, size_t algorithm2) const {
+    if (!observed_) {
+        return cost;  // nothing observed yet: the map alone decides
+    }
+    // The game manager's rate covers the whole game, each player's about half of it
+    return cost * (rate(gameManagers_, game_manager) +
+                   (rate(algorithms_, algorithm1) + rate(algorithms_, algorithm2)) / 2) / 2;
+}
+
+void CostModel::add(std::vector<Rate> &rates, size_t index, double cost, double ms) {
+    if (index >= rates.size()) rates.resize(index + 1);
+    rates[index].ms += ms;
+    rates[index].cost += cost;
+}
+
+void CostModel::observe(double cost, size_t game_manager, size_t algorithm1, size_t algorithm2, double ms) {
+    if (cost <= 0) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    add(gameManagers_, game_manager, cost, ms);
+    add(algorithms_, algorithm1, cost, ms);
+    if (algorithm2 != algorithm1) add(algorithms_, algorithm2, cost, ms);
+    total_.ms += ms;
+    total_.cost += cost;
+    ++games_;
+}
@@ -0,0 +1,60 @@
+#ifndef SIMULATOR_COSTMODEL_H
+#define SIMULATOR_COSTMODEL_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include "MapStore.h"
+
+// Expected running time of a game, to start the longest ones first, in units of
+// map cost: width * height * max_steps * tanks. Before any game finished that is
+// the estimate. Each finished game then teaches the model how fast its
+// libraries play per unit of cost compared to all games so far, and estimates
+// scale by the rates of the game's libraries (1 for a library not seen yet).
+// Safe to use from any thread.
+class CostModel {
+public:
+    static double mapCost(const DecodedMap& map);
+
+    // The libraries' rates at one moment, to estimate many games under one lock
+    class Snapshot {
+    public:
+        // Estimate for a game on a map of mapCost `cost`, between the libraries
+        // at these indices of the simulator's tables
+        double estimate(double cost, size_t game_manager, size_t algorithm1, size_t algorithm2) const;
+        // Games observed when the snapshot was taken
+        size_t games() const { return games_; }
+
+    private:
+        friend class CostModel;
+        static double rate(const std::vector<double>& rates, size_t index);
+
+        bool observed_ = false;             // false: the map alone decides
+        size_t games_ = 0;
+        std::vector<double> gameManagers_;  // relative rates, 0 if not seen yet
+        std::vector<double> algorithms_;
+    };
+    Snapshot snapshot() const;
+    // Games observed so far
+    size_t games() const;
+
+    // A game of mapCost `cost` took `ms`
+    void observe(double cost, size_t game_manager, size_t algorithm1, size_t algorithm2, double ms);
+
+private:
+    struct Rate {
+        double ms = 0;    // time of the library's games
+        double cost = 0;  // and their map cost
+    };
+    // Each library's time per unit of map cost, over that of all games
+    std::vector<double> relativeRates(const std::vector<Rate>& rates) const;
+    static void add(std::vector<Rate>& rates, size_t index, double cost, double ms);
+
+    std::vector<Rate> gameManagers_;
+    std::vector<Rate> algorithms_;
+    Rate total_;
+    size_t games_ = 0;
+    mutable std::mutex mutex_;
+};
+
+#endif // SIMULATOR_COSTMODEL_H
@@ -1,6 +1,7 @@
 #include "GameManagerRegistrar.h"
 
 GameManagerRegistrar GameManagerRegistrar::singleton_;
+thread_local GameManagerRegistrar::GMEntry* GameManagerRegistrar::current_ = nullptr;
 
 GameManagerRegistrar& GameManagerRegistrar::get() {
     return singleton_;
@@ -1,13 +1,17 @@
 #pragma once
 #include <vector>
+#include <deque>
 #include <string>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <cassert>
 #include "../common/AbstractGameManager.h"
 
-// Holds the AbstractGameManager factory for ONE GM .so
+// Holds the AbstractGameManager factory of every GM .so loaded; registration
+// goes through a per-thread LoadContext, as in AlgorithmRegistrar
 class GameManagerRegistrar {
+public:
     class GMEntry {
         std::string so_name_;
         std::function<std::unique_ptr<AbstractGameManager>(bool verbose)> factory_;
@@ -24,45 +28,64 @@ class GameManagerRegistrar {
         }
     };
 
-    std::vector<GMEntry> managers_;
-    static GameManagerRegistrar singleton_;
-
-public:
     struct BadRegistrationException {
         std::string name;
         bool hasName;
         bool hasFactory;
     };
 
-    static GameManagerRegistrar& get();
+    // While alive, what libraries register on this thread goes to `entry`:
+    // construct it right before dlopen of a GM .so
+    class LoadContext {
+        GMEntry* previous_;
+    public:
+        explicit LoadContext(GMEntry& entry) : previous_(current_) { current_ = &entry; }
+        ~LoadContext() { current_ = previous_; }
+        LoadContext(const LoadContext&) = delete;
+        LoadContext& operator=(const LoadContext&) = delete;
+    };
 
-    // BEFORE dlopen of this GM .so
-    void createGameManagerEntry(const std::string& so_base_name) {
-        managers_.emplace_back(so_base_name);
-    }
+    static GameManagerRegistrar& get();
 
-    // Called by GameManagerRegistration (from inside the GM .so)
-    void addGameManagerFactoryToLastEntry(std::function<std::unique_ptr<AbstractGameManager>(bool)> f) {
-        managers_.back().setFactory(std::move(f));
+    // Called by GameManagerRegistration (from inside the GM .so); ignored
+    // outside a LoadContext
+    static void addGameManagerFactory(std::function<std::unique_ptr<AbstractGameManager>(bool)> f) {
+        if (current_) current_->setFactory(std::move(f));
     }
 
     // Validate AFTER dlopen
-    void validateLastRegistration() {
-        const auto& last = managers_.back();
-        bool hasName = !last.name().empty();
-        if (!hasName || !last.hasFactory()) {
+    static void validate(const GMEntry& entry) {
+        bool hasName = !entry.name().empty();
+        if (!hasName || !entry.hasFactory()) {
             throw BadRegistrationException{
-                .name = last.name(),
+                .name = entry.name(),
                 .hasName = hasName,
-                .hasFactory = last.hasFactory()
+                .hasFactory = entry.hasFactory()
             };
         }
     }
-    void removeLast() { managers_.pop_back(); }
 
-    // Iteration
+    // Keep a validated entry, from any thread; it stays at the returned address
+    const GMEntry& add(GMEntry&& entry) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return managers_.emplace_back(std::move(entry));
+    }
+
+    // Iteration, once no library is being loaded
     auto begin() const { return managers_.begin(); }
     auto end()   const { return managers_.end();   }
     std::size_t count() const { return managers_.size(); }
-    void clear() { managers_.clear(); }
-};
\ No newline at end of file
+
+    // Drop every entry; their factories run library code when destroyed, so
+    // before the libraries are closed
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        managers_.clear();
+    }
+
+private:
+    std::deque<GMEntry> managers_;
+    std::mutex mutex_;
+    static thread_local GMEntry* current_;
+    static GameManagerRegistrar singleton_;
+};
@@ -0,0 +1,139 @@
+#include "MapStore.h"
+#include "Parallel.h"
+
+#include "../UserCommon/BulkSatelliteView_212934582_323964676.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+// Parses a positive integer from the digits of an arbitrary string using
+// std::from_chars. Returns 0 on failure.
+size_t parsePositiveNumber(const std::string &s) {
+    std::string num;
+    for (char c : s) {
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            num.push_back(c);
+        }
+    }
+    if (num.empty()) return 0;
+    size_t value = 0;
+    auto [ptr, ec] = std::from_chars(num.data(), num.data() + num.size(), value);
+    if (ec != std::errc()) return 0;
+    return value;
+}
+
+class FileSatelliteView : public UserCommon_212934582_323964676::BulkSatelliteView {
+public:
+    FileSatelliteView(std::vector<std::string> b, size_t width)
+        : board_(std::move(b)), width_(width) {}
+    [[nodiscard]] char getObjectAt(size_t xCoord, size_t yCoord) const override {
+        if (yCoord >= board_.size() || xCoord >= board_[yCoord].size()) return '&';
+        return board_[yCoord][xCoord];
+    }
+
+    // Rows are padded/cut to width_ when the file is read, so rows are plain memcpy
+    std::pair<size_t, size_t> dimensions() const override {
+        return { width_, board_.size() };
+    }
+    void copyRow(size_t yCoord, size_t xCoord, size_t count, char* out) const override {
+        size_t inside = (yCoord < board_.size() && xCoord < width_) ? std::min(count, width_ - xCoord) : 0;
+        if (inside) std::memcpy(out, board_[yCoord].data() + xCoord, inside);
+        std::memset(out + inside, '&', count - inside);
+    }
+
+private:
+    std::vector<std::string> board_;
+    size_t width_;
+};
+
+} // namespace
+
+std::shared_ptr<const DecodedMap> MapStore::decode(const std::string &path) {
+    auto map = std::make_shared<DecodedMap>();
+    map->path = path;
+    map->name = std::filesystem::path(path).filename().string();
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Cannot open map file: " << path << std::endl;
+        return map;
+    }
+
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        lines.push_back(std::move(line));
+    }
+
+    // Header values: name, then MaxSteps, NumShells, Rows, Cols
+    if (lines.size() >= 5) {
+        map->max_steps  = parsePositiveNumber(lines[1]);
+        map->num_shells = parsePositiveNumber(lines[2]);
+        map->height     = parsePositiveNumber(lines[3]);
+        map->width      = parsePositiveNumber(lines[4]);
+    }
+
+    // The board follows the header when the header lines are labelled
+    size_t start_idx = 0;
+    if (lines.size() >= 5 &&
+        lines[1].find("MaxSteps")  != std::string::npos &&
+        lines[2].find("NumShells") != std::string::npos &&
+        lines[3].find("Rows")      != std::string::npos &&
+        lines[4].find("Cols")      != std::string::npos) {
+        start_idx = 5;
+    }
+
+    const size_t width = map->width;
+    std::vector<std::string> board;
+    for (size_t i = 0; i < map->height && start_idx + i < lines.size(); ++i) {
+        std::string row = std::move(lines[start_idx + i]);
+        row.resize(width, ' ');
+        board.push_back(std::move(row));
+    }
+
+    bool found_p1 = false, found_p2 = false;
+    for (size_t y = 0; y < board.size(); ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            char c = board[y][x];
+            if (c == '1' || c == '2') ++map->tanks;
+            if (!found_p1 && c == '1') { map->p1_x = x; map->p1_y = y; found_p1 = true; }
+            else if (!found_p2 && c == '2') { map->p2_x = x; map->p2_y = y; found_p2 = true; }
+        }
+    }
+
+    map->view = std::make_shared<FileSatelliteView>(std::move(board), width);
+    return map;
+}
+
+std::vector<std::shared_ptr<const DecodedMap>> MapStore::load(const std::vector<std::string> &paths, int threads) {
+    std::vector<std::string> pending;
+    for (const auto &path : paths) {
+        if (!maps_.count(path) && std::find(pending.begin(), pending.end(), path) == pending.end()) {
+            pending.push_back(path);
+        }
+    }
+
+    std::vector<std::shared_ptr<const DecodedMap>> decoded(pending.size());
+    forEachInParallel(pending.size(), threads, [&](size_t i) {
+        decoded[i] = decode(pending[i]);
+    });
+    for (size_t i = 0; i < pending.size(); ++i) {
+        maps_.emplace(pending[i], std::move(decoded[i]));
+    }
+
+    std::vector<std::shared_ptr<const DecodedMap>> result;
+    result.reserve(paths.size());
+    for (const auto &path : paths) result.push_back(maps_.at(path));
+    return result;
+}
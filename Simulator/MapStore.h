@@ -0,0 +1,41 @@
+#ifndef SIMULATOR_MAPSTORE_H
+#define SIMULATOR_MAPSTORE_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../common/SatelliteView.h"
+
+// A map file read and decoded once: its header values, its board, and where
+// each player's first tank starts. Never changes once decoded, so every game
+// on the map shares it, on any thread.
+struct DecodedMap {
+    std::string path;
+    std::string name;        // file name, as reported in results
+    size_t width = 0;
+    size_t height = 0;
+    size_t max_steps = 50;
+    size_t num_shells = 10;
+    size_t p1_x = 0, p1_y = 0;  // first '1' and '2' in row-major order (0,0 if none)
+    size_t p2_x = 0, p2_y = 0;
+    size_t tanks = 0;           // tanks of both players
+    std::shared_ptr<const SatelliteView> view;  // null if the file could not be read
+};
+
+// The maps of the simulator's runs, each decoded the first time a run asks
+// for it. Filled before a run's games start and read-only while they play.
+class MapStore {
+public:
+    // The decoded map of every path, decoding those not in the store yet on up
+    // to `threads` threads at once
+    std::vector<std::shared_ptr<const DecodedMap>> load(const std::vector<std::string>& paths, int threads);
+
+private:
+    static std::shared_ptr<const DecodedMap> decode(const std::string& path);
+
+    std::map<std::string, std::shared_ptr<const DecodedMap>> maps_;  // by path
+};
+
+#endif // SIMULATOR_MAPSTORE_H
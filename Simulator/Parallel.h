@@ -0,0 +1,26 @@
+#ifndef SIMULATOR_PARALLEL_H
+#define SIMULATOR_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Calls load(i) for every i below n, on up to `threads` threads at once (the
+// caller's among them); returns when all are done
+template <class Load>
+void forEachInParallel(size_t n, int threads, Load &&load) {
+    std::atomic<size_t> next{0};
+    auto work = [&] {
+        for (size_t i = next++; i < n; i = next++) load(i);
+    };
+    std::vector<std::thread> helpers;
+    for (size_t t = 1; t < std::min(n, static_cast<size_t>(std::max(1, threads))); ++t) {
+        helpers.emplace_back(work);
+    }
+    work();
+    for (auto &helper : helpers) helper.join();
+}
+
+#endif // SIMULATOR_PARALLEL_H
@@ -0,0 +1,195 @@
+#include "ProcessPool.h"
+
+#ifndef _WIN32
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint64_t NO_JOB = UINT64_MAX;
+
+// Shared by the parent and its workers: the dispatch counter, the job each
+// worker is playing, every job's outcome, and the order jobs are taken in
+class SharedTable {
+public:
+    SharedTable(size_t jobs, size_t workers)
+        : jobs_(jobs), workers_(workers),
+          bytes_(sizeof(std::atomic<uint64_t>) * (1 + workers) +
+                 sizeof(GameOutcome) * jobs + sizeof(uint64_t) * jobs) {
+        void* memory = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            memory_ = nullptr;
+            return;
+        }
+        memory_ = static_cast<char*>(memory);
+        new (next()) std::atomic<uint64_t>(0);
+        for (size_t w = 0; w < workers_; ++w) new (&current(w)) std::atomic<uint64_t>(NO_JOB);
+        for (size_t j = 0; j < jobs_; ++j) new (&outcome(j)) GameOutcome();
+    }
+    ~SharedTable() {
+        if (memory_) munmap(memory_, bytes_);
+    }
+    SharedTable(const SharedTable&) = delete;
+    SharedTable& operator=(const SharedTable&) = delete;
+
+    bool ok() const { return memory_ != nullptr; }
+    std::atomic<uint64_t>* next() { return reinterpret_cast<std::atomic<uint64_t>*>(memory_); }
+    std::atomic<uint64_t>& current(size_t worker) { return next()[1 + worker]; }
+    GameOutcome& outcome(size_t job) {
+        return reinterpret_cast<GameOutcome*>(memory_ + sizeof(std::atomic<uint64_t>) * (1 + workers_))[job];
+    }
+    uint64_t& order(size_t k) {
+        return reinterpret_cast<uint64_t*>(reinterpret_cast<char*>(&outcome(0)) + sizeof(GameOutcome) * jobs_)[k];
+    }
+
+private:
+    size_t jobs_;
+    size_t workers_;
+    size_t bytes_;
+    char* memory_;
+};
+
+// Lower the soft limit of `resource` to `value` (never above the hard limit)
+void limit(int resource, rlim_t value) {
+    struct rlimit current{};
+    if (getrlimit(resource, &current) != 0) return;
+    current.rlim_cur = current.rlim_max == RLIM_INFINITY ? value : std::min(value, current.rlim_max);
+    setrlimit(resource, &current);
+}
+
+rlim_t cpuSecondsUsed() {
+    struct rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<rlim_t>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + 1);
+}
+
+[[noreturn]] void workerMain(SharedTable& table, size_t worker, size_t jobs,
+                             const ProcessPool::Limits& limits, const ProcessPool::Job& play) {
+    if (limits.memory_mb) {
+        limit(RLIMIT_AS, static_cast<rlim_t>(limits.memory_mb) << 20);
+    }
+    for (uint64_t k = table.next()->fetch_add(1); k < jobs; k = table.next()->fetch_add(1)) {
+        const uint64_t job = table.order(k);
+        table.current(worker).store(job);
+        if (limits.cpu_seconds) {
+            // RLIMIT_CPU counts the process' whole life: allow this game its share from now
+            limit(RLIMIT_CPU, cpuSecondsUsed() + static_cast<rlim_t>(limits.cpu_seconds));
+        }
+        GameOutcome outcome;
+        try {
+            outcome.state = play(job, outcome) ? GameOutcome::PLAYED : GameOutcome::NO_RESULT;
+        } catch (...) {
+            outcome.state = GameOutcome::CRASHED;
+        }
+        table.outcome(job) = outcome;
+        table.current(worker).store(NO_JOB);
+    }
+    // Leave without the parent's static destructors: they close its libraries
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    _exit(0);
+}
+
+} // namespace
+
+bool ProcessPool::supported() { return true; }
+
+std::string ProcessPool::describeFailure(const GameOutcome& outcome) {
+    if (outcome.state == GameOutcome::PENDING) return "was not played";
+    if (outcome.signal == SIGXCPU) return "exceeded its CPU time limit";
+    if (outcome.signal) return std::string("killed its worker (") + strsignal(outcome.signal) + ")";
+    return "failed in its worker";
+}
+
+std::vector<GameOutcome> ProcessPool::run(size_t jobs, const std::vector<size_t>& order,
+                                          int workers, const Limits& limits, const Job& play) {
+    const size_t count = std::min(static_cast<size_t>(std::max(1, workers)), std::max<size_t>(jobs, 1));
+    SharedTable table(jobs, count);
+    if (!table.ok()) {
+        std::cerr << "Cannot map shared memory for worker processes: " << std::strerror(errno) << std::endl;
+        return std::vector<GameOutcome>(jobs);
+    }
+    for (size_t k = 0; k < order.size() && k < jobs; ++k) {
+        table.order(k) = order[k];
+    }
+
+    std::vector<pid_t> pids(count, -1);
+    size_t alive = 0;
+    auto spawn = [&](size_t worker) {
+        // Anything still buffered would be written again by the child
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+        pid_t pid = fork();
+        if (pid == 0) {
+            workerMain(table, worker, jobs, limits, play);
+        }
+        if (pid < 0) {
+            std::cerr << "Cannot start a worker process: " << std::strerror(errno) << std::endl;
+            return;
+        }
+        pids[worker] = pid;
+        ++alive;
+    };
+    for (size_t w = 0; w < count; ++w) {
+        spawn(w);
+    }
+
+    while (alive > 0) {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        size_t worker = 0;
+        while (worker < count && pids[worker] != pid) ++worker;
+        if (worker == count) continue;
+        pids[worker] = -1;
+        --alive;
+
+        const uint64_t job = table.current(worker).exchange(NO_JOB);
+        if (job != NO_JOB) {
+            GameOutcome& outcome = table.outcome(job);
+            outcome.state = GameOutcome::CRASHED;
+            outcome.signal = WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+        }
+        const bool clean = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        if (!clean && table.next()->load() < jobs) {
+            spawn(worker);
+        }
+    }
+
+    std::vector<GameOutcome> outcomes(jobs);
+    for (size_t j = 0; j < jobs; ++j) {
+        outcomes[j] = table.outcome(j);
+    }
+    return outcomes;
+}
+
+#else // _WIN32
+
+bool ProcessPool::supported() { return false; }
+
+std::string ProcessPool::describeFailure(const GameOutcome&) {
+    return "was not played";
+}
+
+std::vector<GameOutcome> ProcessPool::run(size_t jobs, const std::vector<size_t>&,
+                                          int, const Limits&, const Job&) {
+    return std::vector<GameOutcome>(jobs);
+}
+
+#endif
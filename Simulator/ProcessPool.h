@@ -0,0 +1,59 @@
+#ifndef SIMULATOR_PROCESSPOOL_H
+#define SIMULATOR_PROCESSPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// What a worker process reports back for one game: its GameResult without
+// the final board, as plain data in shared memory
+struct GameOutcome {
+    enum State : int32_t {
+        PENDING,    // not played (yet)
+        PLAYED,     // the fields below hold the result
+        NO_RESULT,  // played, but the game produced no result
+        CRASHED     // its worker died while playing it
+    };
+    static constexpr size_t MAX_PLAYERS = 2;
+
+    int32_t state = PENDING;
+    int32_t winner = 0;
+    int32_t reason = 0;
+    int32_t signal = 0;  // what killed the worker, for CRASHED
+    uint64_t rounds = 0;
+    uint64_t players = 0;
+    uint64_t remaining_tanks[MAX_PLAYERS] = {};
+};
+
+// Runs jobs in forked worker processes, so that a job that crashes, loops or
+// runs out of memory takes down its worker and not the caller. Workers are
+// forked after the caller loaded what the jobs need, and share it copy on
+// write. They take job ids in the given order from a counter in shared memory
+// and write each outcome to its own slot there. A worker that dies is
+// replaced while jobs remain, and the job it was playing is reported CRASHED.
+// POSIX only; the caller must not be running other threads.
+class ProcessPool {
+public:
+    struct Limits {
+        size_t cpu_seconds = 0;  // per job; 0 for none
+        size_t memory_mb = 0;    // address space per worker; 0 for none
+    };
+
+    // Plays one job in a worker; false if it produced no result
+    using Job = std::function<bool(size_t job, GameOutcome& outcome)>;
+
+    static bool supported();
+
+    // Why a job that was not PLAYED or NO_RESULT has no outcome, e.g. "killed
+    // its worker (Segmentation fault)"
+    static std::string describeFailure(const GameOutcome& outcome);
+
+    // Runs every job in `order` on `workers` processes and returns the outcome
+    // of each, by job id (order holds ids below jobs)
+    static std::vector<GameOutcome> run(size_t jobs, const std::vector<size_t>& order,
+                                        int workers, const Limits& limits, const Job& play);
+};
+
+#endif // SIMULATOR_PROCESSPOOL_H
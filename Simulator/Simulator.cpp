@@ -6,8 +6,12 @@
 #include "../common/SatelliteView.h"
 #include "../common/GameResult.h"
 
+#include "../UserCommon/GameManagerOptions_212934582_323964676.h"
+
 #include "AlgorithmRegistrar.h"
 #include "GameManagerRegistrar.h"
+#include "Parallel.h"
+#include "ProcessPool.h"
 
 // Platform-specific dynamic library loading
 #ifdef _WIN32
@@ -25,7 +29,8 @@
 #include <iostream>
 #include <map>
 #include <mutex>
-#include <queue>
+#include <stdexcept>
+#include <deque>
 #include <set>
 #include <sstream>
 #include <string>
@@ -33,26 +38,8 @@
 #include <tuple>
 #include <unordered_map>
 #include <vector>
-#include <cctype>
-#include <charconv>
 
 namespace {
-// Parses a positive integer from an arbitrary string using std::from_chars.
-// Returns 0 on failure.
-size_t parsePositiveNumber(const std::string &s) {
-    std::string num;
-    for (char c : s) {
-        if (std::isdigit(static_cast<unsigned char>(c))) {
-            num.push_back(c);
-        }
-    }
-    if (num.empty()) return 0;
-    size_t value = 0;
-    auto [ptr, ec] = std::from_chars(num.data(), num.data() + num.size(), value);
-    if (ec != std::errc()) return 0;
-    return value;
-}
-
 // Print a brief usage line (for invalid inputs like no maps/algorithms)
 void printUsage() {
     std::cerr
@@ -65,7 +52,6 @@ void printUsage() {
 } // namespace
 
 // ---- platform lib extension (Windows: .dll, Unix: .so) ----
-static std::mutex algorithm_load_mutex;
 #ifdef _WIN32
 static const std::string LIB_EXTENSION = ".dll";
 #else
@@ -80,34 +66,25 @@ Simulator& Simulator::getInstance() {
     return instance;
 }
 
-void Simulator::registerGameManagerFactory(std::function<std::unique_ptr<AbstractGameManager>(bool)> factory) {
-    Simulator::getInstance().gmFactories_.push_back(std::move(factory));
-}
-
-void Simulator::registerPlayerFactory(PlayerFactory factory) {
-    Simulator::getInstance().playerFactories_.push_back(std::move(factory));
-}
-
-void Simulator::registerTankAlgorithmFactory(TankAlgorithmFactory factory) {
-    Simulator::getInstance().tankFactories_.push_back(std::move(factory));
-}
-
 // ------------------------------------------------------------
 // Construction / Destruction
 // ------------------------------------------------------------
-Simulator::Simulator() : stop_workers_(false), verbose_(false) {}
+Simulator::Simulator()
+    : num_workers_(1), next_task_id_(0), verbose_(false), isolated_(false), shard_index_(0), shard_count_(0) {}
 
 Simulator::~Simulator() {
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        stop_workers_ = true;
-    }
-    condition_.notify_all();
+    // Workers stop by themselves once every queue is dry
     for (auto &worker : workers_) {
         if (worker.joinable()) worker.join();
     }
     workers_.clear();
-    
+
+    // The cached factories run library code when destroyed: drop them first
+    algorithms_.clear();
+    gameManagers_.clear();
+    AlgorithmRegistrar::get().clear();
+    GameManagerRegistrar::get().clear();
+
     // Close all loaded dynamic libraries
     for (void* handle : loadedHandles) {
 #ifdef _WIN32
@@ -122,363 +99,411 @@ Simulator::~Simulator() {
 // ------------------------------------------------------------
 // Thread pool implementation
 // ------------------------------------------------------------
-void Simulator::initializeThreadPool(int num_threads, size_t /*total_tasks*/) {
-    stop_workers_ = false;
-    for (int i = 0; i < std::max(1, num_threads); ++i) {
-        workers_.emplace_back(&Simulator::workerThread, this);
-    }
-}
-
-void Simulator::workerThread() {
-    while (true) {
-        GameTask task;
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            condition_.wait(lock, [this] {
-                return stop_workers_ || !task_queue_.empty();
-            });
-            if (stop_workers_ && task_queue_.empty()) {
-                return;
-            }
-            task = task_queue_.front();
-            task_queue_.pop();
-        }
-        SimulatorGameResult result = executeGame(task);
-        {
-            std::lock_guard<std::mutex> lock(results_mutex_);
-            game_results_.push_back(std::move(result));
+void Simulator::initializeThreadPool(int num_threads, size_t total_tasks) {
+    num_workers_ = std::max(1, num_threads);
+    game_results_.clear();
+    game_results_.resize(total_tasks);
+    next_task_id_ = 0;
+    pending_.clear();
+    pending_.reserve(total_tasks);
+}
+
+double Simulator::estimateCost(const CostModel::Snapshot &rates, const GameTask &task) {
+    return rates.estimate(CostModel::mapCost(*task.map), task.game_manager_index,
+                          task.algorithm1_index, task.algorithm2_index);
+}
+
+bool Simulator::takeLongest(size_t from, GameTask &task) {
+    WorkerQueue &queue = *queues_[from];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    // The queue is kept longest expected first. Timings seen since it was
+    // sorted may reorder it, so it is sorted again once the model has seen
+    // twice as many games as then; a take otherwise just pops the front.
+    if (queue.tasks.size() > 1 && cost_model_.games() > 2 * queue.sorted_at) {
+        const CostModel::Snapshot rates = cost_model_.snapshot();
+        std::vector<std::pair<double, size_t>> order;  // cost, index in queue.tasks
+        order.reserve(queue.tasks.size());
+        for (size_t i = 0; i < queue.tasks.size(); ++i) {
+            order.emplace_back(estimateCost(rates, queue.tasks[i]), i);
         }
-        condition_.notify_all();
+        std::stable_sort(order.begin(), order.end(),
+                         [](const auto &a, const auto &b) { return a.first > b.first; });
+        std::deque<GameTask> sorted;
+        for (const auto &entry : order) sorted.push_back(std::move(queue.tasks[entry.second]));
+        queue.tasks.swap(sorted);
+        queue.sorted_at = rates.games();
     }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
 }
 
-void Simulator::submitTask(const GameTask &task) {
-    if (workers_.empty()) {
-        // no pool → run inline
-        SimulatorGameResult result = executeGame(task);
-        std::lock_guard<std::mutex> lock(results_mutex_);
-        game_results_.push_back(std::move(result));
-        return;
+void Simulator::workerThread(size_t worker) {
+    GameTask task;
+    for (;;) {
+        bool found = takeLongest(worker, task);
+        // Own queue dry: steal from the others, starting with the next one.
+        // No task is added once workers run, so all dry means done.
+        for (size_t i = 1; !found && i < queues_.size(); ++i) {
+            found = takeLongest((worker + i) % queues_.size(), task);
+        }
+        if (!found) return;
+        finishTask(task);
     }
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        task_queue_.push(task);
+}
+
+void Simulator::finishTask(const GameTask &task) {
+    auto start = std::chrono::steady_clock::now();
+    game_results_[task.id] = executeGame(task);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    cost_model_.observe(CostModel::mapCost(*task.map), task.game_manager_index,
+                        task.algorithm1_index, task.algorithm2_index, ms);
+}
+
+size_t Simulator::submitTask(GameTask task) {
+    task.id = next_task_id_++;
+    // A shard plays every shard_count_-th task of the run; its slot stays empty otherwise
+    if (shard_count_ == 0 || task.id % shard_count_ == shard_index_) {
+        pending_.push_back(std::move(task));
     }
-    condition_.notify_one();
+    return next_task_id_ - 1;
 }
 
 void Simulator::waitForAllTasks() {
-    if (workers_.empty()) return;
+    // Longest expected first (submission order among equals), each to the
+    // worker with the least expected work so far
+    std::vector<std::pair<double, size_t>> order;  // cost, index in pending_
+    order.reserve(pending_.size());
+    const CostModel::Snapshot rates = cost_model_.snapshot();
+    for (size_t i = 0; i < pending_.size(); ++i) {
+        order.emplace_back(estimateCost(rates, pending_[i]), i);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const auto &a, const auto &b) { return a.first > b.first; });
 
-    // wait until queue drains
-    for (;;) {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        if (task_queue_.empty()) break;
-        lock.unlock();
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (isolated_) {
+        std::vector<size_t> ids;
+        for (const auto &entry : order) ids.push_back(entry.second);
+        runIsolated(ids);
+        return;
     }
 
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        stop_workers_ = true;
+    const size_t workers = std::min(static_cast<size_t>(num_workers_), std::max<size_t>(pending_.size(), 1));
+    queues_.clear();
+    for (size_t w = 0; w < workers; ++w) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    std::vector<double> load(workers, 0.0);
+    for (const auto &[cost, i] : order) {
+        size_t w = std::min_element(load.begin(), load.end()) - load.begin();
+        load[w] += cost;
+        queues_[w]->tasks.push_back(std::move(pending_[i]));
+    }
+    for (auto &queue : queues_) {
+        queue->sorted_at = rates.games();
+    }
+    pending_.clear();
+
+    for (size_t w = 0; w < workers; ++w) {
+        workers_.emplace_back(&Simulator::workerThread, this, w);
     }
-    condition_.notify_all();
 
+    // A worker returns only after its last game and once every queue is dry,
+    // so when all have joined every task has run
     for (auto &worker : workers_) {
         if (worker.joinable()) worker.join();
     }
     workers_.clear();
-    stop_workers_ = false;
+    queues_.clear();
+}
+
+bool Simulator::setIsolatedWorkers(const ProcessPool::Limits &limits) {
+    if (!ProcessPool::supported()) return false;
+    isolated_ = true;
+    limits_ = limits;
+    return true;
+}
+
+void Simulator::runIsolated(const std::vector<size_t> &order) {
+    // Runs in the worker process; only the outcome crosses back
+    auto play = [this](size_t job, GameOutcome &outcome) {
+        SimulatorGameResult result = executeGame(pending_[job]);
+        if (result.game_manager_file.empty()) return false;
+        const GameResult &game = result.game_result;
+        outcome.winner = game.winner;
+        outcome.reason = static_cast<int32_t>(game.reason);
+        outcome.rounds = game.rounds;
+        outcome.players = std::min(game.remaining_tanks.size(), GameOutcome::MAX_PLAYERS);
+        for (size_t p = 0; p < outcome.players; ++p) {
+            outcome.remaining_tanks[p] = game.remaining_tanks[p];
+        }
+        return true;
+    };
+    const auto outcomes = ProcessPool::run(pending_.size(), order, num_workers_, limits_, play);
+
+    for (size_t job = 0; job < outcomes.size(); ++job) {
+        const GameOutcome &outcome = outcomes[job];
+        const GameTask &task = pending_[job];
+        if (outcome.state == GameOutcome::PLAYED) {
+            SimulatorGameResult result = describeGame(task);
+            result.game_result.winner = outcome.winner;
+            result.game_result.reason = static_cast<GameResult::Reason>(outcome.reason);
+            result.game_result.rounds = static_cast<size_t>(outcome.rounds);
+            result.game_result.remaining_tanks.assign(outcome.remaining_tanks,
+                                                      outcome.remaining_tanks + outcome.players);
+            game_results_[task.id] = std::move(result);
+        } else if (outcome.state == GameOutcome::CRASHED || outcome.state == GameOutcome::PENDING) {
+            std::cerr << "Game on " << task.map->name << " between "
+                      << getLibraryName(task.algorithm1_path) << " and "
+                      << getLibraryName(task.algorithm2_path) << " ("
+                      << getLibraryName(task.game_manager_path) << ") "
+                      << ProcessPool::describeFailure(outcome) << "; left out of the results" << std::endl;
+        }
+    }
+    pending_.clear();
+}
+
+void Simulator::dropMissingResults() {
+    // Games that produced no result (unreadable map, crashed worker) score nothing
+    game_results_.erase(std::remove_if(game_results_.begin(), game_results_.end(),
+                                       [](const SimulatorGameResult &result) {
+                                           return result.game_manager_file.empty();
+                                       }),
+                        game_results_.end());
 }
 
 // ------------------------------------------------------------
 // Library loading helpers (registrar pattern)
 // ------------------------------------------------------------
-bool Simulator::loadAlgorithmLibrary(const std::string &library_path) {
-    std::string base = std::filesystem::path(library_path).filename().string();
-
-    // Mark a new expected algorithm entry (so static initializers can fill it)
-    AlgorithmRegistrar::get().createAlgorithmFactoryEntry(base);
+namespace {
 
-    // Load the library directly using platform-specific calls
+// Opens a library; null with the reason in `error` on failure
+void* openLibrary(const std::string &library_path, std::string &error) {
 #ifdef _WIN32
     HMODULE handle = LoadLibraryA(library_path.c_str());
-    if (!handle) {
-        std::cerr << "Failed to load algorithm library: " << library_path << "\n"
-                  << "Error: " << GetLastError() << std::endl;
-        AlgorithmRegistrar::get().removeLast();
-        return false;
-    }
-    loadedHandles.push_back(handle);
+    if (!handle) error = "Error: " + std::to_string(GetLastError());
+    return reinterpret_cast<void*>(handle);
 #else
     void* handle = dlopen(library_path.c_str(), RTLD_NOW | RTLD_GLOBAL);
+    if (!handle) error = std::string("Error: ") + dlerror();
+    return handle;
+#endif
+}
+
+} // namespace
+
+const AlgorithmRegistrar::AlgorithmAndPlayerFactories* Simulator::loadAlgorithmLibrary(
+        const std::string &library_path, void*& handle, std::string &error) {
+    std::string base = std::filesystem::path(library_path).filename().string();
+
+    // The entry the library's static initialisers fill while this thread opens it
+    AlgorithmRegistrar::AlgorithmAndPlayerFactories entry(base);
+    {
+        AlgorithmRegistrar::LoadContext context(entry);
+        handle = openLibrary(library_path, error);
+    }
     if (!handle) {
-        std::cerr << "Failed to load algorithm library: " << library_path << "\n"
-                  << "Error: " << dlerror() << std::endl;
-        AlgorithmRegistrar::get().removeLast();
-        return false;
+        error = "Failed to load algorithm library: " + library_path + "\n" + error;
+        return nullptr;
     }
-    loadedHandles.push_back(handle);
-#endif
 
     try {
-        AlgorithmRegistrar::get().validateLastRegistration();
+        AlgorithmRegistrar::validate(entry);
     } catch (AlgorithmRegistrar::BadRegistrationException& e) {
-        std::cerr << "Error: Algorithm file '" << base
-                  << "' did not register required classes.\n"
-                  << "  name set? " << std::boolalpha << e.hasName << "\n"
-                  << "  player factory? " << e.hasPlayerFactory << "\n"
-                  << "  tank factory? "   << e.hasTankAlgorithmFactory << "\n";
-        AlgorithmRegistrar::get().removeLast();
-        return false;
+        std::ostringstream message;
+        message << "Error: Algorithm file '" << base
+                << "' did not register required classes.\n"
+                << "  name set? " << std::boolalpha << e.hasName << "\n"
+                << "  player factory? " << e.hasPlayerFactory << "\n"
+                << "  tank factory? "   << e.hasTankAlgorithmFactory;
+        error = message.str();
+        return nullptr;
     }
 
-    return true;
+    return &AlgorithmRegistrar::get().add(std::move(entry));
 }
 
-bool Simulator::loadGameManagerLibrary(const std::string &library_path) {
+const GameManagerRegistrar::GMEntry* Simulator::loadGameManagerLibrary(
+        const std::string &library_path, void*& handle, std::string &error) {
     std::string base = std::filesystem::path(library_path).filename().string();
 
-    GameManagerRegistrar::get().createGameManagerEntry(base);
-    
-    // Load the library directly using platform-specific calls
-#ifdef _WIN32
-    HMODULE handle = LoadLibraryA(library_path.c_str());
-    if (!handle) {
-        std::cerr << "Failed to load GameManager library: " << library_path << "\n"
-                  << "Error: " << GetLastError() << std::endl;
-        GameManagerRegistrar::get().removeLast();
-        return false;
+    GameManagerRegistrar::GMEntry entry(base);
+    {
+        GameManagerRegistrar::LoadContext context(entry);
+        handle = openLibrary(library_path, error);
     }
-    loadedHandles.push_back(handle);
-#else
-    void* handle = dlopen(library_path.c_str(), RTLD_NOW | RTLD_GLOBAL);
     if (!handle) {
-        std::cerr << "Failed to load GameManager library: " << library_path << "\n"
-                  << "Error: " << dlerror() << std::endl;
-        GameManagerRegistrar::get().removeLast();
-        return false;
+        error = "Failed to load GameManager library: " + library_path + "\n" + error;
+        return nullptr;
     }
-    loadedHandles.push_back(handle);
-#endif
 
     try {
-        GameManagerRegistrar::get().validateLastRegistration();
+        GameManagerRegistrar::validate(entry);
     } catch (GameManagerRegistrar::BadRegistrationException&) {
-        std::cerr << "Error: GameManager file '" << base
-                  << "' did not register a GameManager class.\n";
-        GameManagerRegistrar::get().removeLast();
-        return false;
+        error = "Error: GameManager file '" + base + "' did not register a GameManager class.";
+        return nullptr;
     }
 
-    return true;
+    return &GameManagerRegistrar::get().add(std::move(entry));
 }
 
-// ------------------------------------------------------------
-// Game execution
-// ------------------------------------------------------------
-SimulatorGameResult Simulator::executeGame(const GameTask &task) {
-    // Create map view (do this first; on failure return empty result)
-    auto map_view = createMapFromFile(task.map_path, task.map_width, task.map_height);
-    if (!map_view) {
-        std::cerr << "Failed to create map from file: " << task.map_path << std::endl;
-        return {};
+std::vector<size_t> Simulator::loadAlgorithms(const std::vector<std::string> &library_paths, int threads) {
+    // Libraries this run is the first to ask for, once each
+    std::vector<std::string> pending;
+    for (const auto &path : library_paths) {
+        if (!algorithmIndex_.count(path) &&
+            std::find(pending.begin(), pending.end(), path) == pending.end()) {
+            pending.push_back(path);
+        }
     }
 
-    SimulatorGameResult result;
-
-    // Store metadata
-    result.game_manager_file = task.game_manager_path;
-    result.algorithm1_file   = task.algorithm1_path;
-    result.algorithm2_file   = task.algorithm2_path;
-    result.map_name          = task.map_name;
-    result.map_path          = task.map_path;
-    result.map_width         = task.map_width;
-    result.map_height        = task.map_height;
-
-    // Find first tanks for players '1' and '2'
-    size_t p1_x = 0, p1_y = 0, p2_x = 0, p2_y = 0;
-    bool found_p1 = false, found_p2 = false;
-    for (size_t y = 0; y < task.map_height; ++y) {
-        for (size_t x = 0; x < task.map_width; ++x) {
-            char c = map_view->getObjectAt(x, y);
-            if (!found_p1 && c == '1') { p1_x = x; p1_y = y; found_p1 = true; }
-            else if (!found_p2 && c == '2') { p2_x = x; p2_y = y; found_p2 = true; }
+    std::vector<const AlgorithmRegistrar::AlgorithmAndPlayerFactories*> entries(pending.size(), nullptr);
+    std::vector<void*> handles(pending.size(), nullptr);
+    std::vector<std::string> errors(pending.size());
+    forEachInParallel(pending.size(), threads, [&](size_t i) {
+        entries[i] = loadAlgorithmLibrary(pending[i], handles[i], errors[i]);
+    });
+
+    // Back on one thread: record them in order, reporting failures as they come
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (handles[i]) loadedHandles.push_back(handles[i]);
+        if (!entries[i]) {
+            std::cerr << errors[i] << std::endl;
+            algorithmIndex_.emplace(pending[i], NOT_LOADED);
+            continue;
         }
+        const auto* entry = entries[i];
+        algorithmIndex_.emplace(pending[i], algorithms_.size());
+        algorithms_.push_back(LoadedAlgorithm{
+            entry->name(),
+            [entry](int player_index, size_t x, size_t y, size_t max_steps, size_t num_shells) {
+                return entry->createPlayer(player_index, x, y, max_steps, num_shells);
+            },
+            [entry](int player_index, int tank_index) {
+                return entry->createTankAlgorithm(player_index, tank_index);
+            }
+        });
     }
 
-    // Load and register algorithms (thread-safe)
-    std::unique_ptr<Player> player1;
-    std::unique_ptr<Player> player2;
-    TankAlgorithmFactory tank_algo_factory1;
-    TankAlgorithmFactory tank_algo_factory2;
-    {
-        std::lock_guard<std::mutex> lock(algorithm_load_mutex);
-        auto &registrar = AlgorithmRegistrar::get();
-        registrar.clear();
+    std::vector<size_t> indices;
+    for (const auto &path : library_paths) indices.push_back(algorithmIndex_.at(path));
+    return indices;
+}
 
-        // Unload any previously loaded algos to force re-registration on next load
-        for (void* handle : loadedHandles) {
-#ifdef _WIN32
-            FreeLibrary((HMODULE)handle);
-#else
-            dlclose(handle);
-#endif
-        }
-        loadedHandles.clear();
-        // Clear after unloading
-        registrar.clear();
-        playerFactories_.clear();
-        tankFactories_.clear();
-
-        if (!loadAlgorithmLibrary(task.algorithm1_path) ||
-            !loadAlgorithmLibrary(task.algorithm2_path)) {
-            std::cerr << "Failed to load algorithm libraries" << std::endl;
-            return result;
+std::vector<size_t> Simulator::loadGameManagers(const std::vector<std::string> &library_paths, int threads) {
+    std::vector<std::string> pending;
+    for (const auto &path : library_paths) {
+        if (!gameManagerIndex_.count(path) &&
+            std::find(pending.begin(), pending.end(), path) == pending.end()) {
+            pending.push_back(path);
         }
+    }
 
-        if (registrar.count() < 2) {
-            std::cerr << "Algorithm registration incomplete. Expected 2, got "
-                      << registrar.count() << std::endl;
-            std::cerr << "Algorithm 1 path: " << task.algorithm1_path << std::endl;
-            std::cerr << "Algorithm 2 path: " << task.algorithm2_path << std::endl;
-            return result;
+    std::vector<const GameManagerRegistrar::GMEntry*> entries(pending.size(), nullptr);
+    std::vector<void*> handles(pending.size(), nullptr);
+    std::vector<std::string> errors(pending.size());
+    forEachInParallel(pending.size(), threads, [&](size_t i) {
+        entries[i] = loadGameManagerLibrary(pending[i], handles[i], errors[i]);
+    });
+
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (handles[i]) loadedHandles.push_back(handles[i]);
+        if (!entries[i]) {
+            std::cerr << errors[i] << std::endl;
+            gameManagerIndex_.emplace(pending[i], NOT_LOADED);
+            continue;
         }
+        const auto* entry = entries[i];
+        gameManagerIndex_.emplace(pending[i], gameManagers_.size());
+        gameManagers_.push_back(LoadedGameManager{
+            entry->name(),
+            [entry](bool verbose) { return entry->create(verbose); }
+        });
+    }
 
-        auto it = registrar.begin();
-        auto algo1 = *it; ++it;
-        auto algo2 = *it;
-
-        result.algorithm1_name = algo1.name();
-        result.algorithm2_name = algo2.name();
+    std::vector<size_t> indices;
+    for (const auto &path : library_paths) indices.push_back(gameManagerIndex_.at(path));
+    return indices;
+}
 
-        player1 = algo1.createPlayer(1, p1_x, p1_y, task.max_steps, task.num_shells);
-        player2 = algo2.createPlayer(2, p2_x, p2_y, task.max_steps, task.num_shells);
+// ------------------------------------------------------------
+// Game execution
+// ------------------------------------------------------------
+SimulatorGameResult Simulator::describeGame(const GameTask &task) const {
+    SimulatorGameResult result;
+    result.game_manager_file = task.game_manager_path;
+    result.algorithm1_file   = task.algorithm1_path;
+    result.algorithm2_file   = task.algorithm2_path;
+    result.map_name          = task.map->name;
+    result.map_path          = task.map->path;
+    result.map_width         = task.map->width;
+    result.map_height        = task.map->height;
+    result.algorithm1_name   = algorithms_[task.algorithm1_index].name;
+    result.algorithm2_name   = algorithms_[task.algorithm2_index].name;
+    result.game_manager_name = gameManagers_[task.game_manager_index].name;
+    return result;
+}
 
-        tank_algo_factory1 = [algo1](int player_index, int tank_index) {
-            return algo1.createTankAlgorithm(player_index, tank_index);
-        };
-        tank_algo_factory2 = [algo2](int player_index, int tank_index) {
-            return algo2.createTankAlgorithm(player_index, tank_index);
-        };
+SimulatorGameResult Simulator::executeGame(const GameTask &task) {
+    // The map was decoded before the run; on failure return empty result
+    const DecodedMap &map = *task.map;
+    if (!map.view) {
+        std::cerr << "Failed to create map from file: " << map.path << std::endl;
+        return {};
     }
 
-    // Load GameManager (fresh each time)
-    // Note: GameManager libraries are loaded fresh each time, so no need to unload here
-    gmFactories_.clear();
-    GameManagerRegistrar::get().clear();
+    SimulatorGameResult result = describeGame(task);
 
-    if (!loadGameManagerLibrary(task.game_manager_path)) {
-        std::cerr << "Failed to load game manager library" << std::endl;
-        return result;
-    }
+    // The libraries of this game were loaded before the run started
+    const LoadedAlgorithm* algo1 = &algorithms_[task.algorithm1_index];
+    const LoadedAlgorithm* algo2 = &algorithms_[task.algorithm2_index];
+    const LoadedGameManager* gm = &gameManagers_[task.game_manager_index];
 
-    auto& gmReg = GameManagerRegistrar::get();
-    if (gmFactories_.empty() || gmReg.count() == 0) {
-        std::cerr << "Error: GameManager file '" << task.game_manager_path
-                  << "' did not register a GameManager class.\n";
-        return result;
-    }
+    std::unique_ptr<Player> player1 = algo1->playerFactory(1, map.p1_x, map.p1_y, map.max_steps, map.num_shells);
+    std::unique_ptr<Player> player2 = algo2->playerFactory(2, map.p2_x, map.p2_y, map.max_steps, map.num_shells);
+    const TankAlgorithmFactory& tank_algo_factory1 = algo1->tankAlgorithmFactory;
+    const TankAlgorithmFactory& tank_algo_factory2 = algo2->tankAlgorithmFactory;
+    auto game_manager = gm->factory(task.verbose);
 
-    auto itGm = gmReg.end();
-    --itGm;
-    result.game_manager_name = itGm->name();
-    auto gm_factory = gmFactories_.back();
-    auto game_manager = gm_factory(task.verbose);
+    // Result files only report winner and reason, so final boards are never
+    // needed; decisions are recorded only when asked for
+    if (auto* options = dynamic_cast<UserCommon_212934582_323964676::GameManagerOptions*>(game_manager.get())) {
+        options->setCaptureFinalState(false);
+        options->setDecisionRecord(decision_record_);
+    }
 
     // RAII cleanup to avoid leaks across games
     auto cleanup = [&]() {
         player1.reset();
         player2.reset();
         game_manager.reset();
-
-
-
-        playerFactories_.clear();
-        tankFactories_.clear();
-        gmFactories_.clear();
-
-        AlgorithmRegistrar::get().clear();
-        GameManagerRegistrar::get().clear();
     };
 
-    GameResult game_result;
+    GameResult game_result{};
     try {
         game_result = game_manager->run(
-            task.map_width, task.map_height,
-            *map_view,
-            task.map_name,
-            task.max_steps, task.num_shells,
+            map.width, map.height,
+            *map.view,
+            map.name,
+            map.max_steps, map.num_shells,
             *player1, result.algorithm1_name, *player2, result.algorithm2_name,
             tank_algo_factory1, tank_algo_factory2
         );
     } catch (...) {
         std::cerr << "GameManager::run threw an exception" << std::endl;
         cleanup();
-        result.game_result = std::move(game_result);
-        return result;
+        return {};  // no result: the game is left out, or reported as failed when isolated
     }
 
+    // Drop the final board even if the manager made one: results are kept until
+    // the run ends, and the snapshot's code lives in a library unloaded before that
+    game_result.gameState.reset();
     result.game_result = std::move(game_result);
     cleanup();
     return result;
 }
 
-// ------------------------------------------------------------
-// Map creation
-// ------------------------------------------------------------
-std::unique_ptr<SatelliteView> Simulator::createMapFromFile(const std::string &map_path,
-                                                            size_t width, size_t height) {
-    std::ifstream file(map_path);
-    if (!file.is_open()) {
-        std::cerr << "Cannot open map file: " << map_path << std::endl;
-        return nullptr;
-    }
-
-    std::vector<std::string> lines;
-    std::string line;
-    while (std::getline(file, line)) {
-        if (!line.empty() && line.back() == '\r') {
-            line.pop_back();
-        }
-        lines.push_back(line);
-    }
-
-    size_t start_idx = 0;
-    // Detect header (name + MaxSteps, NumShells, Rows, Cols)
-    if (lines.size() >= 5 &&
-        lines[1].find("MaxSteps")  != std::string::npos &&
-        lines[2].find("NumShells") != std::string::npos &&
-        lines[3].find("Rows")      != std::string::npos &&
-        lines[4].find("Cols")      != std::string::npos) {
-        start_idx = 5;
-        if (height == 0) height = parsePositiveNumber(lines[3]);
-        if (width  == 0) width  = parsePositiveNumber(lines[4]);
-    }
-
-    std::vector<std::string> board;
-    for (size_t i = 0; i < height && start_idx + i < lines.size(); ++i) {
-        std::string row = lines[start_idx + i];
-        if (row.size() < width)      row += std::string(width - row.size(), ' ');
-        else if (row.size() > width) row = row.substr(0, width);
-        board.push_back(row);
-    }
-
-    class FileSatelliteView : public SatelliteView {
-    public:
-        explicit FileSatelliteView(std::vector<std::string> b) : board_(std::move(b)) {}
-        [[nodiscard]] char getObjectAt(size_t xCoord, size_t yCoord) const override {
-            if (yCoord >= board_.size() || xCoord >= board_[yCoord].size()) return '&';
-            return board_[yCoord][xCoord];
-        }
-
-    private:
-        std::vector<std::string> board_;
-    };
-
-    return std::make_unique<FileSatelliteView>(std::move(board));
-}
-
 // ------------------------------------------------------------
 // Output helpers
 // ------------------------------------------------------------
@@ -633,6 +658,223 @@ void Simulator::writeCompetitionResults(const std::string &algorithms_folder,
     out << output.str();
 }
 
+// ------------------------------------------------------------
+// Shards
+// ------------------------------------------------------------
+// A shard file holds the results one shard of a run played, to be merged with
+// those of the other shards into the run's result file:
+//
+//   shard_format=1
+//   mode=competition|comparative
+//   shard=<index>/<count>
+//   tasks=<tasks in the whole run>
+//   <the run's arguments, as name=value lines>
+//   <empty line>
+//   <task id> TAB <winner> TAB <reason> TAB <rounds> TAB <map name> TAB
+//       <game manager file> TAB <algorithm1 file> TAB <algorithm2 file>
+//
+// one result line per game the shard played, in task order.
+namespace {
+constexpr const char* SHARD_FORMAT = "shard_format=1";
+constexpr const char* SHARD_EXTENSION = ".shard";
+
+struct ShardFile {
+    std::string path;
+    std::vector<std::pair<std::string, std::string>> header;  // but shard=
+    size_t index = 0;
+    size_t count = 0;
+    std::vector<std::pair<size_t, SimulatorGameResult>> results;  // by task id
+};
+
+bool parseShardNumbers(const std::string &value, size_t &index, size_t &count) {
+    size_t slash = value.find('/');
+    if (slash == std::string::npos) return false;
+    try {
+        size_t used_index = 0, used_count = 0;
+        std::string index_text = value.substr(0, slash), count_text = value.substr(slash + 1);
+        index = std::stoul(index_text, &used_index);
+        count = std::stoul(count_text, &used_count);
+        return used_index == index_text.size() && used_count == count_text.size() && count > 0 && index < count;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool readShardFile(const std::string &path, ShardFile &shard, std::string &error) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != SHARD_FORMAT) {
+        error = "not a shard file: " + path;
+        return false;
+    }
+    shard.path = path;
+    bool has_shard = false;
+    size_t line_number = 1;
+    while (std::getline(in, line) && !line.empty()) {
+        ++line_number;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            error = path + ":" + std::to_string(line_number) + ": expected name=value";
+            return false;
+        }
+        std::string name = line.substr(0, eq), value = line.substr(eq + 1);
+        if (name == "shard") {
+            if (!parseShardNumbers(value, shard.index, shard.count)) {
+                error = path + ":" + std::to_string(line_number) + ": bad shard " + value;
+                return false;
+            }
+            has_shard = true;
+        } else {
+            shard.header.emplace_back(name, value);
+        }
+    }
+    if (!has_shard) {
+        error = path + ": no shard line";
+        return false;
+    }
+    while (std::getline(in, line)) {
+        ++line_number;
+        std::vector<std::string> fields;
+        std::istringstream fields_in(line);
+        for (std::string field; std::getline(fields_in, field, '\t');) fields.push_back(field);
+        SimulatorGameResult result;
+        size_t id = 0;
+        try {
+            if (fields.size() != 8) throw std::invalid_argument("fields");
+            id = std::stoul(fields[0]);
+            result.game_result.winner = std::stoi(fields[1]);
+            result.game_result.reason = static_cast<GameResult::Reason>(std::stoi(fields[2]));
+            result.game_result.rounds = std::stoul(fields[3]);
+        } catch (...) {
+            error = path + ":" + std::to_string(line_number) + ": bad result line";
+            return false;
+        }
+        result.map_name          = fields[4];
+        result.game_manager_file = fields[5];
+        result.algorithm1_file   = fields[6];
+        result.algorithm2_file   = fields[7];
+        shard.results.emplace_back(id, std::move(result));
+    }
+    return true;
+}
+
+std::string headerValue(const ShardFile &shard, const std::string &name) {
+    for (const auto &[key, value] : shard.header) {
+        if (key == name) return value;
+    }
+    return {};
+}
+} // namespace
+
+bool Simulator::setShard(const std::string &shard) {
+    size_t index = 0, count = 0;
+    if (!parseShardNumbers(shard, index, count)) return false;
+    shard_index_ = index;
+    shard_count_ = count;
+    return true;
+}
+
+bool Simulator::writeShardResults(const std::string &output_folder, const std::string &mode,
+                                  const std::vector<std::pair<std::string, std::string>> &arguments) {
+    std::ostringstream output;
+    output << SHARD_FORMAT << '\n';
+    output << "mode=" << mode << '\n';
+    output << "shard=" << shard_index_ << '/' << shard_count_ << '\n';
+    output << "tasks=" << game_results_.size() << '\n';
+    for (const auto &[name, value] : arguments) {
+        output << name << '=' << value << '\n';
+    }
+    output << '\n';
+    for (size_t id = 0; id < game_results_.size(); ++id) {
+        const SimulatorGameResult &result = game_results_[id];
+        if (result.game_manager_file.empty()) continue;  // another shard's, or no result
+        output << id << '\t' << result.game_result.winner << '\t' << static_cast<int>(result.game_result.reason)
+               << '\t' << result.game_result.rounds << '\t' << result.map_name << '\t' << result.game_manager_file
+               << '\t' << result.algorithm1_file << '\t' << result.algorithm2_file << '\n';
+    }
+
+    std::filesystem::create_directories(output_folder);
+    std::string path = output_folder + "/" + mode + "_shard_" + std::to_string(shard_index_) + "_of_" +
+                       std::to_string(shard_count_) + SHARD_EXTENSION;
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create shard results file: " << path << std::endl;
+        return false;
+    }
+    out << output.str();
+    return static_cast<bool>(out);
+}
+
+bool Simulator::mergeShards(const std::string &shards_folder) {
+    auto files = getFilesInFolder(shards_folder, SHARD_EXTENSION);
+    if (files.empty()) {
+        std::cerr << "No shard files found in folder: " << shards_folder << std::endl;
+        return false;
+    }
+
+    std::vector<ShardFile> shards(files.size());
+    for (size_t f = 0; f < files.size(); ++f) {
+        std::string error;
+        if (!readShardFile(shards_folder + "/" + files[f], shards[f], error)) {
+            std::cerr << "Error: " << error << std::endl;
+            return false;
+        }
+    }
+
+    // Every shard of one run, each once
+    const ShardFile &first = shards.front();
+    std::vector<const ShardFile*> by_index(first.count, nullptr);
+    for (const auto &shard : shards) {
+        if (shard.count != first.count || shard.header != first.header) {
+            std::cerr << "Error: " << shard.path << " is not from the same run as " << first.path << std::endl;
+            return false;
+        }
+        if (by_index[shard.index]) {
+            std::cerr << "Error: shard " << shard.index << " appears twice: " << by_index[shard.index]->path
+                      << " and " << shard.path << std::endl;
+            return false;
+        }
+        by_index[shard.index] = &shard;
+    }
+    std::string missing;
+    for (size_t i = 0; i < by_index.size(); ++i) {
+        if (!by_index[i]) missing += (missing.empty() ? "" : ", ") + std::to_string(i);
+    }
+    if (!missing.empty()) {
+        std::cerr << "Error: missing shard(s) " << missing << " of " << first.count << std::endl;
+        return false;
+    }
+
+    // Results in task order, as the run on one machine keeps them
+    std::vector<std::pair<size_t, SimulatorGameResult>> merged;
+    for (auto &shard : shards) {
+        for (auto &entry : shard.results) merged.push_back(std::move(entry));
+    }
+    std::sort(merged.begin(), merged.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+    std::vector<SimulatorGameResult> results;
+    results.reserve(merged.size());
+    for (size_t i = 0; i < merged.size(); ++i) {
+        if (i && merged[i].first == merged[i - 1].first) {
+            std::cerr << "Error: task " << merged[i].first << " has results in two shards" << std::endl;
+            return false;
+        }
+        results.push_back(std::move(merged[i].second));
+    }
+
+    const std::string mode = headerValue(first, "mode");
+    if (mode == "competition") {
+        writeCompetitionResults(shards_folder, headerValue(first, "game_maps_folder"),
+                                headerValue(first, "game_manager"), results);
+    } else if (mode == "comparative") {
+        writeComparativeResults(shards_folder, results);
+    } else {
+        std::cerr << "Error: unknown mode in " << first.path << ": " << mode << std::endl;
+        return false;
+    }
+    return true;
+}
+
 // ------------------------------------------------------------
 // Utility helpers
 // ------------------------------------------------------------
@@ -694,34 +936,45 @@ bool Simulator::runComparative(const std::string &game_map, const std::string &g
         return false;
     }
 
-    // parse map metadata (optional header)
-    size_t width = 0, height = 0, max_steps = 50, num_shells = 10;
-    {
-        std::ifstream map_file(game_map);
-        if (map_file.is_open()) {
-            std::vector<std::string> lines;
-            std::string l;
-            while (std::getline(map_file, l)) lines.push_back(l);
-            if (lines.size() >= 5) {
-                max_steps  = parsePositiveNumber(lines[1]);
-                num_shells = parsePositiveNumber(lines[2]);
-                height     = parsePositiveNumber(lines[3]);
-                width      = parsePositiveNumber(lines[4]);
-            }
+    // Load every library before the first game; workers only look factories up.
+    // A game manager that fails to load is left out of the comparison.
+    std::vector<size_t> algo_indices = loadAlgorithms({algorithm1, algorithm2}, num_threads);
+    if (algo_indices[0] == NOT_LOADED || algo_indices[1] == NOT_LOADED) {
+        std::cerr << "Failed to load algorithm libraries" << std::endl;
+        return false;
+    }
+    std::vector<std::string> gm_paths;
+    for (const auto &gm_file : gm_files) {
+        gm_paths.push_back(game_managers_folder + "/" + gm_file);
+    }
+    std::vector<size_t> gm_indices = loadGameManagers(gm_paths, num_threads);
+    std::vector<std::pair<std::string, size_t>> game_managers;  // path, index
+    for (size_t i = 0; i < gm_paths.size(); ++i) {
+        if (gm_indices[i] != NOT_LOADED) {
+            game_managers.emplace_back(gm_paths[i], gm_indices[i]);
         }
     }
+    if (game_managers.empty()) {
+        std::cerr << "No GameManager library could be loaded from folder: "
+                  << game_managers_folder << std::endl;
+        return false;
+    }
 
-    std::string map_name = std::filesystem::path(game_map).filename().string();
+    const auto map = maps_.load({game_map}, 1)[0];
 
-    initializeThreadPool(std::max(1, num_threads), gm_files.size());
-    for (const auto &gm_file : gm_files) {
-        std::string gm_path = game_managers_folder + "/" + gm_file;
-        GameTask task(gm_path, algorithm1, algorithm2, game_map,
-                      map_name, width, height, max_steps, num_shells, verbose);
-        submitTask(task);
+    initializeThreadPool(std::max(1, num_threads), game_managers.size());
+    for (const auto &[gm_path, gm_index] : game_managers) {
+        GameTask task(gm_path, algorithm1, algorithm2, map, verbose,
+                      gm_index, algo_indices[0], algo_indices[1]);
+        submitTask(std::move(task));
     }
 
     waitForAllTasks();
+    if (shard_count_) {
+        return writeShardResults(game_managers_folder, "comparative",
+                                 {{"game_map", game_map}, {"algorithm1", algorithm1}, {"algorithm2", algorithm2}});
+    }
+    dropMissingResults();
     writeComparativeResults(game_managers_folder, game_results_);
     return true;
 }
@@ -739,13 +992,35 @@ bool Simulator::runCompetition(const std::string &game_maps_folder, const std::s
         return false;
     }
 
-    // algorithms (*.dll/.so) whose name contains "Algorithm"
+    // Load every library before the first game; workers only look factories up
+    const size_t gm_index = loadGameManagers({game_manager}, 1)[0];
+    if (gm_index == NOT_LOADED) {
+        std::cerr << "Failed to load game manager library" << std::endl;
+        return false;
+    }
+
+    // algorithms (*.dll/.so) whose name contains "Algorithm"; one that fails
+    // to load is left out of the tournament
     auto algo_files = getFilesInFolder(algorithms_folder, LIB_EXTENSION);
     algo_files.erase(std::remove_if(algo_files.begin(), algo_files.end(),
                                     [](const std::string &f) {
                                         return f.find("Algorithm") == std::string::npos;
                                     }),
                      algo_files.end());
+    std::vector<std::string> algo_paths;
+    for (const auto &algo_file : algo_files) {
+        algo_paths.push_back(algorithms_folder + "/" + algo_file);
+    }
+    std::vector<size_t> loaded = loadAlgorithms(algo_paths, num_threads);
+    std::vector<std::string> loaded_files;
+    std::vector<size_t> algo_indices;
+    for (size_t i = 0; i < algo_files.size(); ++i) {
+        if (loaded[i] != NOT_LOADED) {
+            loaded_files.push_back(algo_files[i]);
+            algo_indices.push_back(loaded[i]);
+        }
+    }
+    algo_files = std::move(loaded_files);
     const size_t N = algo_files.size();
     if (N < 2) {
         std::cerr << "Need at least two algorithm libraries in folder: "
@@ -754,38 +1029,22 @@ bool Simulator::runCompetition(const std::string &game_maps_folder, const std::s
         return false;
     }
 
-    const size_t total_tasks = map_files.size() * (N * (N - 1) / 2);
-    if (verbose_) {
-        std::cout << "Total tasks to be created: " << total_tasks << std::endl;
+    // Every map is read and decoded once, before the first game
+    std::vector<std::string> map_paths;
+    for (const auto &map_file : map_files) {
+        map_paths.push_back(game_maps_folder + "/" + map_file);
     }
-
-    initializeThreadPool(std::max(1, num_threads), total_tasks);
+    const auto maps = maps_.load(map_paths, num_threads);
 
     // Round-robin tournament-style pairing that varies by map index k
+    std::vector<GameTask> tasks;
     for (size_t k = 0; k < map_files.size(); ++k) {
         const auto &map_file = map_files[k];
-        std::string map_path = game_maps_folder + "/" + map_file;
-        std::string map_name = map_file;
 
         if (verbose_) {
             std::cout << "\nMap " << k << " (" << map_file << ") pairings:" << std::endl;
         }
 
-        // parse map metadata (optional header)
-        size_t width = 0, height = 0, max_steps = 50, num_shells = 10;
-        std::ifstream map_file_stream(map_path);
-        if (map_file_stream.is_open()) {
-            std::vector<std::string> lines;
-            std::string l;
-            while (std::getline(map_file_stream, l)) lines.push_back(l);
-            if (lines.size() >= 5) {
-                max_steps  = parsePositiveNumber(lines[1]);
-                num_shells = parsePositiveNumber(lines[2]);
-                height     = parsePositiveNumber(lines[3]);
-                width      = parsePositiveNumber(lines[4]);
-            }
-        }
-
         for (size_t i = 0; i < N; ++i) {
             // Tournament formula: j = (i + 1 + k % (N - 1)) % N
             size_t j = (i + 1 + (N > 1 ? (k % (N - 1)) : 0)) % N;
@@ -804,13 +1063,26 @@ bool Simulator::runCompetition(const std::string &game_maps_folder, const std::s
             std::string alg1_path = algorithms_folder + "/" + algo_files[i];
             std::string alg2_path = algorithms_folder + "/" + algo_files[j];
 
-            GameTask task(game_manager, alg1_path, alg2_path, map_path,
-                          map_name, width, height, max_steps, num_shells, verbose);
-            submitTask(task);
+            tasks.emplace_back(game_manager, alg1_path, alg2_path, maps[k], verbose,
+                               gm_index, algo_indices[i], algo_indices[j]);
         }
     }
 
+    // The pool is sized for exactly these tasks
+    if (verbose_) {
+        std::cout << "Total tasks to be created: " << tasks.size() << std::endl;
+    }
+    initializeThreadPool(std::max(1, num_threads), tasks.size());
+    for (auto &task : tasks) {
+        submitTask(std::move(task));
+    }
+
     waitForAllTasks();
+    if (shard_count_) {
+        return writeShardResults(algorithms_folder, "competition",
+                                 {{"game_maps_folder", game_maps_folder}, {"game_manager", game_manager}});
+    }
+    dropMissingResults();
     writeCompetitionResults(algorithms_folder, game_maps_folder, game_manager, game_results_);
     return true;
 }
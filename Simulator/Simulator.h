@@ -4,10 +4,10 @@
 #include <string>
 #include <vector>
 #include <thread>
-#include <queue>
+#include <deque>
 #include <mutex>
-#include <condition_variable>
 #include <memory>
+#include <map>
 #include "../common/SatelliteView.h"
 #include "../common/GameResult.h"
 #include "../common/AbstractGameManager.h"
@@ -17,6 +17,12 @@
 #include "../common/AbstractGameManager.h"
 #include "../common/Player.h"
 #include "../common/TankAlgorithm.h"
+#include "AlgorithmRegistrar.h"
+#include "GameManagerRegistrar.h"
+#include "MapStore.h"
+#include "CostModel.h"
+#include "ProcessPool.h"
+#include <cstdint>
 // Platform-specific dynamic library loading
 // No dynamic library loading needed
 
@@ -64,37 +70,35 @@ struct SimulatorGameResult {
 
 // Game task structure for thread pool
 struct GameTask {
+    size_t id;  // order of submission in its run: the slot of its result
     std::string game_manager_path;
     std::string algorithm1_path;
     std::string algorithm2_path;
-    std::string map_path;
-    std::string map_name;
-    size_t map_width;
-    size_t map_height;
-    size_t max_steps;
-    size_t num_shells;
+    size_t game_manager_index;  // The libraries' entries in the Simulator's loaded tables
+    size_t algorithm1_index;
+    size_t algorithm2_index;
+    std::shared_ptr<const DecodedMap> map;  // decoded once by the MapStore, shared by the games on it
     bool verbose;
     
     // Default constructor
     GameTask() 
-        : max_steps(50)
-        , num_shells(10)
-        , map_width(0)
-        , map_height(0)
+        : id(0)
+        , game_manager_index(0)
+        , algorithm1_index(0)
+        , algorithm2_index(0)
         , verbose(false) {}
     
     GameTask(const std::string& gm, const std::string& alg1, const std::string& alg2, 
-             const std::string& map, const std::string& map_name, 
-             size_t width, size_t height, size_t steps, size_t shells, bool v)
-        : game_manager_path(gm)
+             std::shared_ptr<const DecodedMap> m, bool v,
+             size_t gm_index, size_t alg1_index, size_t alg2_index)
+        : id(0)
+        , game_manager_path(gm)
         , algorithm1_path(alg1)
         , algorithm2_path(alg2)
-        , map_path(map)
-        , map_name(map_name)
-        , map_width(width)
-        , map_height(height)
-        , max_steps(steps)
-        , num_shells(shells)
+        , game_manager_index(gm_index)
+        , algorithm1_index(alg1_index)
+        , algorithm2_index(alg2_index)
+        , map(std::move(m))
         , verbose(v) {}
 };
 
@@ -106,10 +110,6 @@ public:
     // Singleton instance accessor
     static Simulator& getInstance();
 
-    // Registration functions used by static registration objects
-    static void registerGameManagerFactory(std::function<std::unique_ptr<AbstractGameManager>(bool)> factory);
-    static void registerPlayerFactory(PlayerFactory factory);
-    static void registerTankAlgorithmFactory(TankAlgorithmFactory factory);
     // Main entry points for the two modes
     bool runComparative(const std::string& game_map, const std::string& game_managers_folder,
                        const std::string& algorithm1, const std::string& algorithm2,
@@ -118,22 +118,76 @@ public:
     bool runCompetition(const std::string& game_maps_folder, const std::string& game_manager,
                        const std::string& algorithms_folder, int num_threads = 1, bool verbose = false);
 
+    // Have every game manager that supports it append the tank decisions of
+    // its games to `path` (see GameManagerOptions); set before running
+    void setDecisionRecord(const std::string& path) { decision_record_ = path; }
+
+    // Play every game in a worker process instead of a thread (POSIX only),
+    // so a library that crashes or runs away loses only its game. Workers are
+    // forked once libraries and maps are loaded; the limits apply to each.
+    // Returns false if the platform cannot.
+    bool setIsolatedWorkers(const ProcessPool::Limits& limits);
+
+    // Play only shard "<index>/<count>" of the run: every count-th task of its
+    // task list, starting at index, which is the same on every machine. The
+    // shard writes its results to a .shard file next to where the run's
+    // result file would go; mergeShards then writes that result file from the
+    // .shard files of all the shards, as one run would have. False if `shard`
+    // is not index/count with index < count.
+    bool setShard(const std::string& shard);
+    bool mergeShards(const std::string& shards_folder);
+
 private:
-    // Thread pool management
+    // Thread pool management. A run prepares the pool for exactly total_tasks
+    // tasks and submits them; waitForAllTasks then deals them out, longest
+    // expected first, to one queue per worker, and returns once all finished.
+    // A worker whose queue ran dry steals from the others.
     void initializeThreadPool(int num_threads, size_t total_tasks);
-    void workerThread();
-    void submitTask(const GameTask& task);
+    void workerThread(size_t worker);
+    // Returns the task's id. The id is the task's handle: it indexes the task's
+    // result in game_results_
+    size_t submitTask(GameTask task);
     void waitForAllTasks();
+    void finishTask(const GameTask& task);
+    static double estimateCost(const CostModel::Snapshot& rates, const GameTask& task);
+    // Play the pending tasks, in `order`, on worker processes
+    void runIsolated(const std::vector<size_t>& order);
+    void dropMissingResults();
+    // Take the task expected to run longest, the front, from queue `from`;
+    // false if empty
+    bool takeLongest(size_t from, GameTask& task);
     
-    // Dynamic library loading
-    bool loadAlgorithmLibrary(const std::string& library_path);
-    bool loadGameManagerLibrary(const std::string& library_path);
+    // Dynamic library loading: open one library and collect what it registers,
+    // on any thread. Returns its registrar entry, or null with the reason in
+    // `error`; `handle` is set to the library (to close with the simulator) if it opened.
+    static const AlgorithmRegistrar::AlgorithmAndPlayerFactories* loadAlgorithmLibrary(
+        const std::string& library_path, void*& handle, std::string& error);
+    static const GameManagerRegistrar::GMEntry* loadGameManagerLibrary(
+        const std::string& library_path, void*& handle, std::string& error);
+
+    // Factories of a library loaded earlier in this run
+    struct LoadedAlgorithm {
+        std::string name;
+        PlayerFactory playerFactory;
+        TankAlgorithmFactory tankAlgorithmFactory;
+    };
+    struct LoadedGameManager {
+        std::string name;
+        std::function<std::unique_ptr<AbstractGameManager>(bool)> factory;
+    };
+    // Load and validate the libraries of a run before its games start, those
+    // not loaded by an earlier run on up to `threads` threads at once. Returns
+    // the index of each in algorithms_ (gameManagers_), NOT_LOADED if it failed.
+    static constexpr size_t NOT_LOADED = SIZE_MAX;
+    std::vector<size_t> loadAlgorithms(const std::vector<std::string>& library_paths, int threads);
+    std::vector<size_t> loadGameManagers(const std::vector<std::string>& library_paths, int threads);
     
     // Game execution
     // Note: Simulator creates Player objects as raw pointers (cannot assume copy constructors exist)
     // Passes references to GameManager, ownership stays with Simulator
     SimulatorGameResult executeGame(const GameTask& task);
-    static std::unique_ptr<SatelliteView> createMapFromFile(const std::string& map_path, size_t width, size_t height);
+    // A result with the game's files, map and library names, but no outcome
+    SimulatorGameResult describeGame(const GameTask& task) const;
 
     // Output generation
     static void writeComparativeResults(const std::string& output_folder,
@@ -142,6 +196,8 @@ private:
                                         const std::string& game_maps_folder,
                                         const std::string& game_manager_file,
                                         const std::vector<SimulatorGameResult>& results);
+    bool writeShardResults(const std::string& output_folder, const std::string& mode,
+                           const std::vector<std::pair<std::string, std::string>>& arguments);
 
     // Utility functions
     static std::string getLibraryName(const std::string& path);
@@ -149,25 +205,42 @@ private:
     static std::string generateTimestamp();
     
     // Thread pool members
+    struct WorkerQueue {
+        std::deque<GameTask> tasks;  // longest expected first
+        std::mutex mutex;
+        size_t sorted_at = 0;        // CostModel::games() when tasks were last sorted
+    };
+    int num_workers_;
     std::vector<std::thread> workers_;
-    std::queue<GameTask> task_queue_;
-    std::mutex queue_mutex_;
-    std::condition_variable condition_;
-    bool stop_workers_;
+    std::vector<GameTask> pending_;                      // submitted, not yet dealt out
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;  // one per worker
+    CostModel cost_model_;
     
-    // Results storage
+    // Results storage: one slot per task of the run, sized before the first
+    // is submitted, so each worker writes its own slot without locking
     std::vector<SimulatorGameResult> game_results_;
-    std::mutex results_mutex_;
+    size_t next_task_id_;
     
     // Configuration
     bool verbose_;
+    std::string decision_record_;  // empty: decisions are not recorded
+    bool isolated_;                // games run in worker processes
+    ProcessPool::Limits limits_;
+    size_t shard_index_;
+    size_t shard_count_;           // 0: the whole run
 
     // Keep track of open dynamic library handles for later dlclose()
     std::vector<void*> loadedHandles;
-    // Registered factories (populated via static registration when libraries are loaded)
-    std::vector<std::function<std::unique_ptr<AbstractGameManager>(bool)>> gmFactories_;
-    std::vector<PlayerFactory> playerFactories_;
-    std::vector<TankAlgorithmFactory> tankFactories_;
+    // The factories of every library, loaded before the first game of a run
+    // and left alone until its last, so workers index them without locking.
+    // Each library is opened once, by path, and only closed with the
+    // simulator: a library opened again would not run its registration again
+    std::vector<LoadedAlgorithm> algorithms_;
+    std::vector<LoadedGameManager> gameManagers_;
+    std::map<std::string, size_t> algorithmIndex_;    // by path
+    std::map<std::string, size_t> gameManagerIndex_;  // by path
+    // Every map of a run, decoded before its first game; games read no files
+    MapStore maps_;
 };
 
 #endif // SIMULATOR_H
@@ -6,6 +6,7 @@
 #include <filesystem>
 #include <iostream>
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -27,13 +28,19 @@ static void printUsage(const char* prog, const std::string& err = {}) {
         << "Usage:\n"
         << "  " << prog << " -comparative "
         << "game_map=<path.txt> game_managers_folder=<dir> algorithm1=<file" DYN_LIB_EXT "> algorithm2=<file" DYN_LIB_EXT ">"
-        << " [num_threads=<N>] [-verbose]\n\n"
+        << " [num_threads=<N>] [record_decisions=<file>] [-isolated [worker_cpu_seconds=<N>] [worker_memory_mb=<N>]] [shard=<i>/<n>] [-verbose]\n\n"
         << "  " << prog << " -competition "
         << "game_maps_folder=<dir> game_manager=<file" DYN_LIB_EXT "> algorithms_folder=<dir>"
-        << " [num_threads=<N>] [-verbose]\n\n"
+        << " [num_threads=<N>] [record_decisions=<file>] [-isolated [worker_cpu_seconds=<N>] [worker_memory_mb=<N>]] [shard=<i>/<n>] [-verbose]\n\n"
+        << "  " << prog << " -merge shards_folder=<dir>\n\n"
         << "Notes:\n"
         << "  - Paths can be relative to the current working directory.\n"
-        << "  - On Windows, dynamic libraries use " DYN_LIB_EXT "; on Linux/macOS, they use " DYN_LIB_EXT ".\n";
+        << "  - On Windows, dynamic libraries use " DYN_LIB_EXT "; on Linux/macOS, they use " DYN_LIB_EXT ".\n"
+        << "  - record_decisions appends every tank decision to a file, for the policy table builder.\n"
+        << "  - -isolated plays games in num_threads worker processes (Linux/macOS); a game that crashes\n"
+        << "    or passes worker_cpu_seconds of CPU time is left out, worker_memory_mb caps each worker.\n"
+        << "  - shard=<i>/<n> plays only the i-th of n parts of the run (0 <= i < n) and writes a .shard\n"
+        << "    file; -merge writes the run's result file from the .shard files of all n parts.\n";
 }
 
 // ------------------------------------------------------------------
@@ -67,7 +74,7 @@ std::string getArgumentName(const std::string& arg) {
 // Argument parsing (now mode can be anywhere, unknown args collected)
 // ------------------------------------------------------------------
 bool parseArguments(int argc, char* argv[], std::map<std::string, std::string>& args,
-                    bool& verbose, int& num_threads) {
+                    bool& verbose, bool& isolated, int& num_threads) {
     if (argc < 2) {
         printUsage(argv[0], "No arguments provided");
         return false;
@@ -77,26 +84,29 @@ bool parseArguments(int argc, char* argv[], std::map<std::string, std::string>&
     int mode_index = -1;
     for (int i = 1; i < argc; ++i) {
         std::string token = argv[i];
-        if (token == "-comparative" || token == "-competition") {
+        if (token == "-comparative" || token == "-competition" || token == "-merge") {
             mode_index = i;
             args["mode"] = token;
             break;
         }
     }
     if (mode_index == -1) {
-        printUsage(argv[0], "Missing mode: -comparative or -competition");
+        printUsage(argv[0], "Missing mode: -comparative, -competition or -merge");
         return false;
     }
 
     verbose = false;
+    isolated = false;
     num_threads = 1;
 
     // required args per mode
     std::vector<std::string> required_args;
     if (args["mode"] == "-comparative") {
         required_args = {"game_map", "game_managers_folder", "algorithm1", "algorithm2"};
-    } else { // -competition
+    } else if (args["mode"] == "-competition") {
         required_args = {"game_maps_folder", "game_manager", "algorithms_folder"};
+    } else { // -merge
+        required_args = {"shards_folder"};
     }
 
     std::vector<std::string> unknown_args;
@@ -111,6 +121,10 @@ bool parseArguments(int argc, char* argv[], std::map<std::string, std::string>&
             verbose = true;
             continue;
         }
+        if (arg == "-isolated") {
+            isolated = true;
+            continue;
+        }
 
         std::string name  = getArgumentName(arg);
         std::string value = getArgumentValue(arg);
@@ -129,6 +143,28 @@ bool parseArguments(int argc, char* argv[], std::map<std::string, std::string>&
             continue;
         }
 
+        if (name == "record_decisions" || name == "shard") {
+            args[name] = value;
+            continue;
+        }
+
+        if (name == "worker_cpu_seconds" || name == "worker_memory_mb") {
+            try {
+                // std::stoul would accept a sign (and wrap "-5") or leading spaces
+                if (value.empty() || !std::isdigit(static_cast<unsigned char>(value[0]))) {
+                    throw std::invalid_argument(name);
+                }
+                size_t used = 0;
+                std::stoul(value, &used);
+                if (used != value.size()) throw std::invalid_argument(name);
+            } catch (...) {
+                printUsage(argv[0], "Invalid " + name + " value: " + value);
+                return false;
+            }
+            args[name] = value;
+            continue;
+        }
+
         bool is_valid = false;
         for (const auto& req : required_args) {
             if (name == req) {
@@ -205,6 +241,9 @@ bool validatePaths(const std::map<std::string, std::string>& args, const char* p
                                "Invalid game_managers_folder: ")) return false;
         if (!requireFile(args.at("algorithm1"), "algorithm1 not found: ")) return false;
         if (!requireFile(args.at("algorithm2"), "algorithm2 not found: ")) return false;
+    } else if (args.at("mode") == "-merge") {
+        if (!requireDirWithExt(args.at("shards_folder"), ".shard",
+                               "Invalid shards_folder: ")) return false;
     } else { // -competition
         if (!requireDirWithExt(args.at("game_maps_folder"), ".txt",
                                "Invalid game_maps_folder: ")) return false;
@@ -230,18 +269,36 @@ int main(int argc, char* argv[]) {
 
     std::map<std::string, std::string> args;
     bool verbose = false;
+    bool isolated = false;
     int num_threads = 1;
 
-    if (!parseArguments(argc, argv, args, verbose, num_threads) ||
+    if (!parseArguments(argc, argv, args, verbose, isolated, num_threads) ||
         !validatePaths(args, argv[0])) {
         return 1;
     }
 
     try {
         auto& simulator = Simulator::getInstance();
+        if (args.count("record_decisions")) {
+            simulator.setDecisionRecord(args.at("record_decisions"));
+        }
+        if (args.count("shard") && !simulator.setShard(args.at("shard"))) {
+            printUsage(argv[0], "Invalid shard (expected <i>/<n> with i < n): " + args.at("shard"));
+            return 1;
+        }
+        if (isolated) {
+            ProcessPool::Limits limits;
+            if (args.count("worker_cpu_seconds")) limits.cpu_seconds = std::stoul(args.at("worker_cpu_seconds"));
+            if (args.count("worker_memory_mb")) limits.memory_mb = std::stoul(args.at("worker_memory_mb"));
+            if (!simulator.setIsolatedWorkers(limits)) {
+                std::cerr << "Worker processes are not supported on this platform; games run on threads" << std::endl;
+            }
+        }
 
         bool ok = false;
-        if (args["mode"] == "-comparative") {
+        if (args["mode"] == "-merge") {
+            ok = simulator.mergeShards(args.at("shards_folder"));
+        } else if (args["mode"] == "-comparative") {
             ok = simulator.runComparative(
                 args.at("game_map"),
                 args.at("game_managers_folder"),
@@ -0,0 +1,244 @@
+// BoardScan.h - Vectorised searches for sets of board characters, along rows and rays
+#ifndef USERCOMMON_BOARDSCAN_212934582_323964676_H
+#define USERCOMMON_BOARDSCAN_212934582_323964676_H
+
+#include "SharedGrid_212934582_323964676.h"
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+// x86 builds compare 16 board characters at a time with SSE2 (always there on
+// x86-64) and 32 with AVX2 when the CPU has it, chosen once at run time. The
+// AVX2 kernels are compiled for AVX2 on their own, so the rest of the build
+// needs no -mavx2. Other targets use the scalar loops.
+#if defined(__GNUC__) && defined(__SSE2__)
+#define USERCOMMON_BOARDSCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace UserCommon_212934582_323964676 {
+
+// A small set of board characters, e.g. CharSet("#@12") for everything that
+// stops a shot. Up to MAX_CHARS characters; the vector kernels compare against
+// each of them, the scalar ones use a lookup table.
+class CharSet {
+public:
+    static constexpr size_t MAX_CHARS = 16;
+
+    CharSet() : size_(0) { member_.fill(false); }
+
+    // Every character of the null-terminated `chars` (the first MAX_CHARS)
+    explicit CharSet(const char* chars) : CharSet() {
+        for (; *chars && size_ < MAX_CHARS; ++chars) {
+            add(*chars);
+        }
+    }
+
+    void add(char c) {
+        if (!contains(c) && size_ < MAX_CHARS) {
+            member_[static_cast<unsigned char>(c)] = true;
+            chars_[size_++] = c;
+        }
+    }
+
+    bool contains(char c) const { return member_[static_cast<unsigned char>(c)]; }
+    size_t size() const { return size_; }
+    char at(size_t i) const { return chars_[i]; }
+
+private:
+    std::array<bool, 256> member_;
+    std::array<char, MAX_CHARS> chars_;
+    size_t size_;
+};
+
+// Searches of one row of a board (or any run of characters), and of the rays
+// shots travel along. Rows are searched with the vector kernels; a vertical or
+// diagonal ray touches one character per row of a Grid, whose rows are
+// separate strings, so it is walked with the set's lookup table instead.
+class BoardScan {
+public:
+    // Index of the first character of data[0, n) in `set`, or n when there is none
+    static size_t findFirst(const char* data, size_t n, const CharSet& set) {
+#ifdef USERCOMMON_BOARDSCAN_X86
+        if (hasAvx2()) return findFirstAvx2(data, n, set);
+        return findFirstSse2(data, n, set);
+#else
+        return findFirstScalar(data, n, set, 0);
+#endif
+    }
+
+    // Index of the last character of data[0, n) in `set`, or n when there is none
+    static size_t findLast(const char* data, size_t n, const CharSet& set) {
+#ifdef USERCOMMON_BOARDSCAN_X86
+        if (hasAvx2()) return findLastAvx2(data, n, set);
+        return findLastSse2(data, n, set);
+#else
+        return findLastScalar(data, n, set, n);
+#endif
+    }
+
+    // out[i] = 1 when data[i] is in `set`, else 0, for i in [0, n)
+    static void markMembers(const char* data, size_t n, const CharSet& set, uint8_t* out) {
+#ifdef USERCOMMON_BOARDSCAN_X86
+        if (hasAvx2()) return markMembersAvx2(data, n, set, out);
+        return markMembersSse2(data, n, set, out);
+#else
+        markMembersScalar(data, n, set, out, 0);
+#endif
+    }
+
+    // Call f(i) for every i in [0, n), in order, with data[i] in `set`
+    template <typename F>
+    static void forEach(const char* data, size_t n, const CharSet& set, F&& f) {
+        for (size_t i = findFirst(data, n, set); i < n; ) {
+            f(i);
+            ++i;
+            i += findFirst(data + i, n - i, set);
+        }
+    }
+
+    // Steps from board[r][c] along (dr, dc) to the first cell in `stop`, or to
+    // the last cell of the board when none is: the cells a shot fired from
+    // (r, c) passes through, the last one being what it hits, if anything.
+    // 0 when the very first step leaves the board.
+    static size_t rayLength(const Grid& board, size_t r, size_t c, int dr, int dc, const CharSet& stop) {
+        const std::string& line = board[r];
+        if (dr == 0 && dc > 0) {
+            size_t begin = c + 1 < line.size() ? c + 1 : line.size();
+            size_t n = line.size() - begin;
+            size_t i = findFirst(line.data() + begin, n, stop);
+            return i < n ? i + 1 : n;
+        }
+        if (dr == 0 && dc < 0) {
+            size_t n = c < line.size() ? c : line.size();
+            size_t i = findLast(line.data(), n, stop);
+            return i < n ? c - i : c;
+        }
+        size_t steps = 0;
+        const ptrdiff_t rows = static_cast<ptrdiff_t>(board.size());
+        for (ptrdiff_t rr = static_cast<ptrdiff_t>(r) + dr, cc = static_cast<ptrdiff_t>(c) + dc;
+             rr >= 0 && rr < rows && cc >= 0 && static_cast<size_t>(cc) < board[rr].size();
+             rr += dr, cc += dc) {
+            ++steps;
+            if (stop.contains(board[rr][cc])) break;
+        }
+        return steps;
+    }
+
+private:
+    // tests/BoardScanTest.cpp runs every kernel against the scalar loops
+    friend class BoardScanTest;
+
+    static size_t findFirstScalar(const char* data, size_t n, const CharSet& set, size_t i) {
+        for (; i < n; ++i) {
+            if (set.contains(data[i])) return i;
+        }
+        return n;
+    }
+
+    // Searches data[0, end) from the back
+    static size_t findLastScalar(const char* data, size_t n, const CharSet& set, size_t end) {
+        while (end > 0) {
+            if (set.contains(data[--end])) return end;
+        }
+        return n;
+    }
+
+    static void markMembersScalar(const char* data, size_t n, const CharSet& set, uint8_t* out, size_t i) {
+        for (; i < n; ++i) {
+            out[i] = set.contains(data[i]) ? 1 : 0;
+        }
+    }
+
+#ifdef USERCOMMON_BOARDSCAN_X86
+    static bool hasAvx2() {
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2;
+    }
+
+    // Lanes of `block` equal to some character of the set, as 0xFF
+    static __m128i matchSse2(__m128i block, const CharSet& set) {
+        __m128i hit = _mm_setzero_si128();
+        for (size_t k = 0; k < set.size(); ++k) {
+            hit = _mm_or_si128(hit, _mm_cmpeq_epi8(block, _mm_set1_epi8(set.at(k))));
+        }
+        return hit;
+    }
+
+    static size_t findFirstSse2(const char* data, size_t n, const CharSet& set) {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matchSse2(block, set)));
+            if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+        }
+        return findFirstScalar(data, n, set, i);
+    }
+
+    static size_t findLastSse2(const char* data, size_t n, const CharSet& set) {
+        size_t end = n;
+        for (; end >= 16; end -= 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + end - 16));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matchSse2(block, set)));
+            if (mask) return end - 16 + static_cast<size_t>(31 - __builtin_clz(mask));
+        }
+        return findLastScalar(data, n, set, end);
+    }
+
+    static void markMembersSse2(const char* data, size_t n, const CharSet& set, uint8_t* out) {
+        const __m128i one = _mm_set1_epi8(1);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_and_si128(matchSse2(block, set), one));
+        }
+        markMembersScalar(data, n, set, out, i);
+    }
+
+    __attribute__((target("avx2")))
+    static __m256i matchAvx2(__m256i block, const CharSet& set) {
+        __m256i hit = _mm256_setzero_si256();
+        for (size_t k = 0; k < set.size(); ++k) {
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(set.at(k))));
+        }
+        return hit;
+    }
+
+    __attribute__((target("avx2")))
+    static size_t findFirstAvx2(const char* data, size_t n, const CharSet& set) {
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(matchAvx2(block, set)));
+            if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+        }
+        return findFirstScalar(data, n, set, i);
+    }
+
+    __attribute__((target("avx2")))
+    static size_t findLastAvx2(const char* data, size_t n, const CharSet& set) {
+        size_t end = n;
+        for (; end >= 32; end -= 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + end - 32));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(matchAvx2(block, set)));
+            if (mask) return end - 32 + static_cast<size_t>(31 - __builtin_clz(mask));
+        }
+        return findLastScalar(data, n, set, end);
+    }
+
+    __attribute__((target("avx2")))
+    static void markMembersAvx2(const char* data, size_t n, const CharSet& set, uint8_t* out) {
+        const __m256i one = _mm256_set1_epi8(1);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_and_si256(matchAvx2(block, set), one));
+        }
+        markMembersScalar(data, n, set, out, i);
+    }
+#endif
+};
+
+} // namespace UserCommon_212934582_323964676
+
+#endif // USERCOMMON_BOARDSCAN_212934582_323964676_H
@@ -0,0 +1,134 @@
+// BulkSatelliteView.h - Optional bulk-read extension of SatelliteView
+#ifndef USERCOMMON_BULKSATELLITEVIEW_212934582_323964676_H
+#define USERCOMMON_BULKSATELLITEVIEW_212934582_323964676_H
+
+#include "../common/SatelliteView.h"
+#include "SharedGrid_212934582_323964676.h"
+#include "ChangeJournal_212934582_323964676.h"
+#include <vector>
+#include <string>
+#include <utility>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+namespace UserCommon_212934582_323964676 {
+
+// A SatelliteView that can also hand out its size and whole rows at once.
+// Views we produce implement it; consumers discover it with asBulk() and keep
+// the per-cell getObjectAt() path for views that do not.
+class BulkSatelliteView : public SatelliteView {
+public:
+    // Map size as (width, height)
+    virtual std::pair<size_t, size_t> dimensions() const = 0;
+
+    // Copy `count` cells of row y, starting at column x, into out.
+    // Cells outside the map read as '&', exactly like getObjectAt().
+    virtual void copyRow(size_t y, size_t x, size_t count, char* out) const = 0;
+
+    // Copy a width x height block whose top-left cell is (x,y) into out,
+    // one row after the other, `stride` chars apart.
+    virtual void copyRegion(size_t x, size_t y, size_t width, size_t height,
+                            char* out, size_t stride) const {
+        for (size_t r = 0; r < height; ++r) {
+            copyRow(y + r, x, width, out + r * stride);
+        }
+    }
+
+    // The whole view as a shared read-only grid (what getObjectAt() reports, except
+    // that the '%' cell keeps its underlying character), or nullptr if the view
+    // cannot share one. Lets a consumer use the board without copying it.
+    virtual GridSnapshot snapshot() const { return nullptr; }
+
+    // Position getObjectAt() reports as '%', if the view has one
+    virtual bool selfPosition(size_t& x, size_t& y) const {
+        (void)x;
+        (void)y;
+        return false;
+    }
+
+    // Sequence number of the board this view shows (see ChangeJournal); 0 when
+    // the view keeps no journal
+    virtual uint64_t sequence() const { return 0; }
+
+    // Append the cells that changed between sequence `since` and sequence() to
+    // out. Returns false when the view cannot tell (no journal, or a gap), in
+    // which case the caller must fall back to the whole board.
+    virtual bool changesSince(uint64_t since, std::pmr::vector<CellChange>& out) const {
+        (void)since;
+        (void)out;
+        return false;
+    }
+};
+
+// Returns the bulk interface of view, or nullptr if it only offers getObjectAt()
+inline const BulkSatelliteView* asBulk(const SatelliteView& view) {
+    return dynamic_cast<const BulkSatelliteView*>(&view);
+}
+
+// Map size as (width, height); probes for the '&' border when the view has no dimensions()
+inline std::pair<size_t, size_t> viewDimensions(const SatelliteView& view) {
+    if (const BulkSatelliteView* bulk = asBulk(view)) {
+        return bulk->dimensions();
+    }
+    size_t width = 0;
+    while (view.getObjectAt(width, 0) != '&') {
+        ++width;
+    }
+    size_t height = 0;
+    while (view.getObjectAt(0, height) != '&') {
+        ++height;
+    }
+    return { width, height };
+}
+
+// Copy `count` cells of row y starting at column x into out, through copyRow() when available
+inline void readRow(const SatelliteView& view, size_t y, size_t x, size_t count, char* out) {
+    if (const BulkSatelliteView* bulk = asBulk(view)) {
+        bulk->copyRow(y, x, count, out);
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = view.getObjectAt(x + i, y);
+    }
+}
+
+// Fill board (height rows of width chars, board[row][col]) from view
+inline void readBoard(const SatelliteView& view, size_t width, size_t height,
+                      std::vector<std::string>& board) {
+    board.resize(height);
+    for (size_t y = 0; y < height; ++y) {
+        board[y].resize(width);
+        readRow(view, y, 0, width, &board[y][0]);
+    }
+}
+
+// The whole view as a shared grid plus our own position (row, col), with the '%'
+// cell holding `self`. Shares the view's snapshot() when it has one, and only
+// otherwise reads the board into a fresh grid.
+inline GridSnapshot readSnapshot(const SatelliteView& view, char self,
+                                 size_t& self_row, size_t& self_col) {
+    self_row = self_col = 0;
+    if (const BulkSatelliteView* bulk = asBulk(view)) {
+        if (GridSnapshot grid = bulk->snapshot()) {
+            bulk->selfPosition(self_col, self_row);
+            return grid;
+        }
+    }
+    auto [width, height] = viewDimensions(view);
+    auto board = std::make_shared<Grid>();
+    readBoard(view, width, height, *board);
+    for (size_t y = 0; y < height; ++y) {
+        size_t x = (*board)[y].find('%');
+        if (x != std::string::npos) {
+            self_row = y;
+            self_col = x;
+            (*board)[y][x] = self;
+        }
+    }
+    return board;
+}
+
+} // namespace UserCommon_212934582_323964676
+
+#endif // USERCOMMON_BULKSATELLITEVIEW_212934582_323964676_H
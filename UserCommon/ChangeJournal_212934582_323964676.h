@@ -0,0 +1,51 @@
+// ChangeJournal.h - Sequence-numbered log of board cell changes
+#ifndef USERCOMMON_CHANGEJOURNAL_212934582_323964676_H
+#define USERCOMMON_CHANGEJOURNAL_212934582_323964676_H
+
+#include <vector>
+#include <memory_resource>
+#include <cstdint>
+#include <cstddef>
+
+namespace UserCommon_212934582_323964676 {
+
+// One cell of the shared board taking a new character
+struct CellChange {
+    uint32_t row;
+    uint32_t col;
+    char cell;                          // The character the cell holds from now on
+
+    CellChange(uint32_t row_, uint32_t col_, char cell_) : row(row_), col(col_), cell(cell_) {}
+};
+
+// Append-only record of every change to a board. The sequence number is the
+// count of changes recorded so far, so a reader that last saw sequence s
+// catches up by replaying changes [s, sequence()).
+class ChangeJournal {
+public:
+    void record(size_t row, size_t col, char cell) {
+        changes_.emplace_back(static_cast<uint32_t>(row), static_cast<uint32_t>(col), cell);
+    }
+
+    uint64_t sequence() const { return changes_.size(); }
+
+    // Append the changes that took the board from sequence `since` to sequence
+    // `until` to out. Returns false when the range does not belong to this
+    // journal (the reader has to start over from a full board).
+    bool changesBetween(uint64_t since, uint64_t until, std::pmr::vector<CellChange>& out) const {
+        if (since > until || until > changes_.size()) {
+            return false;
+        }
+        out.insert(out.end(),
+                   changes_.begin() + static_cast<std::ptrdiff_t>(since),
+                   changes_.begin() + static_cast<std::ptrdiff_t>(until));
+        return true;
+    }
+
+private:
+    std::vector<CellChange> changes_;
+};
+
+} // namespace UserCommon_212934582_323964676
+
+#endif // USERCOMMON_CHANGEJOURNAL_212934582_323964676_H
@@ -0,0 +1,75 @@
+// DeadReckoning.h - A tank's own facing and shells, tracked from its own actions
+#ifndef USERCOMMON_DEADRECKONING_212934582_323964676_H
+#define USERCOMMON_DEADRECKONING_212934582_323964676_H
+
+#include "Utils_212934582_323964676.h"
+#include "../common/ActionRequest.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace UserCommon_212934582_323964676 {
+
+// Rotations needed to face `to` from `from`: 0, 1 (up to 90 degrees) or 2
+inline int rotationCost(Direction from, Direction to) {
+    int diff = (static_cast<int>(to) - static_cast<int>(from) + 8) % 8;
+    int steps = std::min(diff, 8 - diff);
+    return steps == 0 ? 0 : steps <= 2 ? 1 : 2;
+}
+
+// The direction whose vector has the same signs as (dr, dc): exact for a cell
+// on the same row, column or diagonal, rough otherwise
+inline Direction directionTowards(int dr, int dc) {
+    int sr = (dr > 0) - (dr < 0);
+    int sc = (dc > 0) - (dc < 0);
+    for (int d = 0; d < 8; ++d) {
+        auto v = DirectionUtils::toVector(static_cast<Direction>(d));
+        if (v.first == sr && v.second == sc) {
+            return static_cast<Direction>(d);
+        }
+    }
+    return Direction::UP;
+}
+
+// The satellite view shows where a tank is, but players report neither its
+// facing nor its shells. Both follow from the tank's own actions: tanks start
+// facing the other side (player 1 left, player 2 right), the first battle info
+// carries the initial shell count, and after that only rotations turn the tank
+// and only shots that hit spend a shell (the game refuses the others and the
+// tank keeps its shell).
+class DeadReckoning {
+public:
+    explicit DeadReckoning(int player_index)
+        : direction_(player_index == 1 ? Direction::LEFT : Direction::RIGHT), shells_(0), shells_known_(false) {}
+
+    // Called with every battle info; only the first one's count is used
+    void onBattleInfo(size_t shells_remaining) {
+        if (!shells_known_) {
+            shells_ = static_cast<int>(shells_remaining);
+            shells_known_ = true;
+        }
+    }
+
+    // The tank asked for `action`; `shot_hits` says whether a Shoot will be carried out
+    void apply(ActionRequest action, bool shot_hits) {
+        switch (action) {
+            case ActionRequest::RotateLeft45:  direction_ = DirectionUtils::rotate45ccw(direction_); break;
+            case ActionRequest::RotateRight45: direction_ = DirectionUtils::rotate45cw(direction_); break;
+            case ActionRequest::RotateLeft90:  direction_ = DirectionUtils::rotate90(direction_, false); break;
+            case ActionRequest::RotateRight90: direction_ = DirectionUtils::rotate90(direction_, true); break;
+            case ActionRequest::Shoot:         if (shot_hits && shells_ > 0) --shells_; break;
+            default: break;
+        }
+    }
+
+    Direction direction() const { return direction_; }
+    int shells() const { return shells_; }
+
+private:
+    Direction direction_;
+    int shells_;
+    bool shells_known_;
+};
+
+} // namespace UserCommon_212934582_323964676
+
+#endif // USERCOMMON_DEADRECKONING_212934582_323964676_H
@@ -0,0 +1,27 @@
+// GameManagerOptions.h - Optional settings a GameManager can accept from the Simulator
+#ifndef USERCOMMON_GAMEMANAGEROPTIONS_212934582_323964676_H
+#define USERCOMMON_GAMEMANAGEROPTIONS_212934582_323964676_H
+
+#include <string>
+
+namespace UserCommon_212934582_323964676 {
+
+// Game managers that implement this next to AbstractGameManager let the
+// Simulator tune them; the Simulator finds it with dynamic_cast and leaves
+// managers that do not implement it alone. Settings are made once, before
+// the first game is run.
+class GameManagerOptions {
+public:
+    virtual ~GameManagerOptions() = default;
+
+    // Whether run() should fill GameResult::gameState (default: true)
+    virtual void setCaptureFinalState(bool capture) = 0;
+
+    // Append every tank decision of the games run() plays to the file at
+    // `path`, as PolicyFeatures words (default: empty, nothing is recorded)
+    virtual void setDecisionRecord(const std::string& path) = 0;
+};
+
+} // namespace UserCommon_212934582_323964676
+
+#endif // USERCOMMON_GAMEMANAGEROPTIONS_212934582_323964676_H
@@ -0,0 +1,130 @@
+// MoveMask.h - Per-cell "legal moves" bitmasks shared between projects
+#ifndef USERCOMMON_MOVEMASK_212934582_323964676_H
+#define USERCOMMON_MOVEMASK_212934582_323964676_H
+
+#include "Utils_212934582_323964676.h"
+#include "BoardScan_212934582_323964676.h"
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+namespace UserCommon_212934582_323964676 {
+
+// One byte per cell: bit d is set when a tank standing on the cell may step one
+// cell in Direction d. The target must be on the map and hold no wall, mine or tank.
+// With corner-cut checking on, a diagonal step additionally needs both orthogonal
+// cells it squeezes between to be free (the rule AggressiveTankAI plans with).
+class MoveMaskGrid {
+public:
+    MoveMaskGrid() : rows_(0), cols_(0), corner_cut_(false) {}
+
+    // Cells a tank can never enter
+    static bool isBlocked(char c) {
+        return c == '#' || c == '@' || c == '1' || c == '2';
+    }
+
+    // Compute every mask from scratch - board[row][col]. The blocked cells are
+    // found a row at a time with BoardScan, into a grid with a blocked border,
+    // so that each mask is then eight lookups at fixed offsets.
+    void build(const std::vector<std::string>& board, size_t rows, size_t cols, bool corner_cut) {
+        static const CharSet blocking("#@12");
+        rows_ = rows;
+        cols_ = cols;
+        corner_cut_ = corner_cut;
+        masks_.assign(rows * cols, 0);
+
+        const ptrdiff_t width = static_cast<ptrdiff_t>(cols) + 2;
+        std::vector<uint8_t> blocked((rows + 2) * width, 1);
+        for (size_t r = 0; r < rows; ++r) {
+            const std::string& line = board[r];
+            BoardScan::markMembers(line.data(), std::min(cols, line.size()), blocking, &blocked[(r + 1) * width + 1]);
+        }
+
+        ptrdiff_t target[8], sideRow[8], sideCol[8];
+        for (int d = 0; d < 8; ++d) {
+            auto [dr, dc] = DirectionUtils::toVector(static_cast<Direction>(d));
+            target[d] = dr * width + dc;
+            sideRow[d] = dr * width;
+            sideCol[d] = dc;
+        }
+        for (size_t r = 0; r < rows; ++r) {
+            const uint8_t* cell = &blocked[(r + 1) * width + 1];
+            uint8_t* masks = &masks_[r * cols];
+            for (size_t c = 0; c < cols; ++c, ++cell) {
+                uint8_t mask = 0;
+                for (int d = 0; d < 8; ++d) {
+                    if (cell[target[d]]) continue;
+                    if (corner_cut_ && sideRow[d] != 0 && sideCol[d] != 0 &&
+                        (cell[sideCol[d]] || cell[sideRow[d]])) {
+                        continue;
+                    }
+                    mask |= static_cast<uint8_t>(1u << d);
+                }
+                masks[c] = mask;
+            }
+        }
+    }
+
+    // Call after board[row][col] changed. Only the masks of the cell's 3x3
+    // neighbourhood can depend on it (as a target or as a corner), so only
+    // those are recomputed.
+    void cellChanged(const std::vector<std::string>& board, size_t row, size_t col) {
+        if (masks_.empty()) return;
+        size_t r0 = row > 0 ? row - 1 : 0;
+        size_t c0 = col > 0 ? col - 1 : 0;
+        size_t r1 = row + 1 < rows_ ? row + 1 : rows_ - 1;
+        size_t c1 = col + 1 < cols_ ? col + 1 : cols_ - 1;
+        for (size_t r = r0; r <= r1; ++r) {
+            for (size_t c = c0; c <= c1; ++c) {
+                masks_[r * cols_ + c] = computeMask(board, r, c);
+            }
+        }
+    }
+
+    uint8_t at(size_t row, size_t col) const { return masks_[row * cols_ + col]; }
+
+    bool canMove(size_t row, size_t col, Direction d) const {
+        return row < rows_ && col < cols_ && (at(row, col) >> static_cast<int>(d)) & 1u;
+    }
+
+    bool empty() const { return masks_.empty(); }
+    const std::vector<uint8_t>& masks() const { return masks_; }
+
+    // Release the mask storage to the caller (e.g. to hand it over in a MyBattleInfo)
+    std::vector<uint8_t> release() { rows_ = cols_ = 0; return std::move(masks_); }
+
+private:
+    size_t rows_, cols_;
+    bool corner_cut_;
+    std::vector<uint8_t> masks_;
+
+    bool blockedAt(const std::vector<std::string>& board, int r, int c) const {
+        if (r < 0 || c < 0 || static_cast<size_t>(r) >= rows_ || static_cast<size_t>(c) >= cols_) {
+            return true;
+        }
+        const std::string& line = board[r];
+        return static_cast<size_t>(c) >= line.size() || isBlocked(line[c]);
+    }
+
+    uint8_t computeMask(const std::vector<std::string>& board, size_t row, size_t col) const {
+        uint8_t mask = 0;
+        int r = static_cast<int>(row);
+        int c = static_cast<int>(col);
+        for (int d = 0; d < 8; ++d) {
+            auto [dr, dc] = DirectionUtils::toVector(static_cast<Direction>(d));
+            if (blockedAt(board, r + dr, c + dc)) continue;
+            if (corner_cut_ && dr != 0 && dc != 0 &&
+                (blockedAt(board, r, c + dc) || blockedAt(board, r + dr, c))) {
+                continue;
+            }
+            mask |= static_cast<uint8_t>(1u << d);
+        }
+        return mask;
+    }
+};
+
+} // namespace UserCommon_212934582_323964676
+
+#endif // USERCOMMON_MOVEMASK_212934582_323964676_H
@@ -3,8 +3,11 @@
 #define USERCOMMON_MYBATTLEINFO_212934582_323964676_H
 
 #include "../common/BattleInfo.h"
+#include "SharedGrid_212934582_323964676.h"
 #include <vector>
 #include <string>
+#include <memory>
+#include <cstdint>
 #include <cstddef>
 
 namespace UserCommon_212934582_323964676 {
@@ -13,16 +16,17 @@ namespace UserCommon_212934582_323964676 {
 struct MyBattleInfo : public BattleInfo {
     size_t rows;                        // Map height
     size_t cols;                        // Map width
-    std::vector<std::string> board;     // Full snapshot of the map
+    GridSnapshot board;                 // Full snapshot of the map, shared and read-only
     size_t x;                           // This tank's row
     size_t y;                           // This tank's col
     int direction;                      // This tank's facing (0-7, will be cast to Direction when needed)
     size_t shells_remaining;            // How many shells it has
+    std::shared_ptr<const std::vector<uint8_t>> move_masks;  // Optional per-cell legal-move bits (see MoveMaskGrid), null if not provided
 
-    // Construct with everything at once
+    // Construct with everything at once; the board snapshot is shared, not copied
     MyBattleInfo(size_t rows_,
                  size_t cols_,
-                 std::vector<std::string> board_,
+                 GridSnapshot board_,
                  size_t x_,
                  size_t y_,
                  int dir_,
@@ -35,6 +39,17 @@ struct MyBattleInfo : public BattleInfo {
       , direction(dir_)
       , shells_remaining(shells_)
     {}
+
+    // Same, taking ownership of a freshly built board
+    MyBattleInfo(size_t rows_,
+                 size_t cols_,
+                 Grid board_,
+                 size_t x_,
+                 size_t y_,
+                 int dir_,
+                 size_t shells_)
+      : MyBattleInfo(rows_, cols_, std::make_shared<const Grid>(std::move(board_)), x_, y_, dir_, shells_)
+    {}
 };
 
 } // namespace UserCommon_212934582_323964676
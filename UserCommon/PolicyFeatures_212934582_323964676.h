@@ -0,0 +1,129 @@
+// PolicyFeatures.h - Compact local description of a tank's situation, for policy tables
+#ifndef USERCOMMON_POLICYFEATURES_212934582_323964676_H
+#define USERCOMMON_POLICYFEATURES_212934582_323964676_H
+
+#include "Utils_212934582_323964676.h"
+#include "SharedGrid_212934582_323964676.h"
+#include "BoardScan_212934582_323964676.h"
+#include "../common/ActionRequest.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+
+namespace UserCommon_212934582_323964676 {
+
+// What a tank sees around itself, reduced to a few bits so that recorded
+// decisions generalise across maps and positions:
+//  - ring: the 8 cells around the tank (empty, wall, mine, a tank of ours, an
+//    enemy tank, a shell, off the map), 3 bits each, in Direction order
+//  - facing: the tank's Direction
+//  - enemyDirection: which of the 8 directions the nearest enemy lies in, by
+//    its angle (NO_ENEMY when none is left), and enemyRange its Chebyshev
+//    distance in 4 buckets (up to 2, 5, 12, further)
+//  - shells: the tank's shells in 4 buckets (none, up to 2, 9, more)
+//  - onTarget: a shot now would hit an enemy, by the engine's ray rule
+// key() packs them into KEY_BITS bits. The board is the one players see:
+// board[row][col], tanks as '1' and '2', shells as '*'. A decision, recorded
+// or looked up, is the key and the action in one nonzero 64-bit word.
+struct PolicyFeatures {
+    static constexpr unsigned KEY_BITS = 36;
+    static constexpr uint8_t NO_ENEMY = 8;
+
+    enum Cell : uint8_t { EMPTY, WALL, MINE, FRIEND, ENEMY, SHELL, OFF_MAP };
+
+    uint8_t ring[8];
+    uint8_t facing;
+    uint8_t enemyDirection;
+    uint8_t enemyRange;
+    uint8_t shells;
+    bool    onTarget;
+
+    // Describe the tank of `player` (1 or 2) on board[row][col] facing `facing`
+    static PolicyFeatures describe(const Grid& board, size_t row, size_t col, int facing, size_t shells, int player) {
+        PolicyFeatures f;
+        const char own = player == 1 ? '1' : '2';
+        const char enemy = player == 1 ? '2' : '1';
+        const int rows = static_cast<int>(board.size());
+        for (int d = 0; d < 8; ++d) {
+            auto [dr, dc] = DirectionUtils::toVector(static_cast<Direction>(d));
+            const int r = static_cast<int>(row) + dr, c = static_cast<int>(col) + dc;
+            if (r < 0 || r >= rows || c < 0 || c >= static_cast<int>(board[r].size())) {
+                f.ring[d] = OFF_MAP;
+                continue;
+            }
+            const char ch = board[r][c];
+            f.ring[d] = ch == '#' ? WALL : ch == '@' ? MINE : ch == own ? FRIEND
+                      : ch == enemy ? ENEMY : ch == '*' ? SHELL : EMPTY;
+        }
+        f.facing = static_cast<uint8_t>(facing & 7);
+        f.shells = shells == 0 ? 0 : shells <= 2 ? 1 : shells <= 9 ? 2 : 3;
+
+        // Nearest enemy, a row at a time with the vector kernels
+        const CharSet enemies(enemy == '1' ? "1" : "2");
+        int nearest = -1, nearRow = 0, nearCol = 0;
+        for (int r = 0; r < rows; ++r) {
+            BoardScan::forEach(board[r].data(), board[r].size(), enemies, [&](size_t c) {
+                int dist = std::max(std::abs(r - static_cast<int>(row)), std::abs(static_cast<int>(c) - static_cast<int>(col)));
+                if (nearest < 0 || dist < nearest) {
+                    nearest = dist;
+                    nearRow = r;
+                    nearCol = static_cast<int>(c);
+                }
+            });
+        }
+        if (nearest < 0) {
+            f.enemyDirection = NO_ENEMY;
+            f.enemyRange = 3;
+        } else {
+            f.enemyDirection = static_cast<uint8_t>(sector(nearRow - static_cast<int>(row), nearCol - static_cast<int>(col)));
+            f.enemyRange = nearest <= 2 ? 0 : nearest <= 5 ? 1 : nearest <= 12 ? 2 : 3;
+        }
+
+        // The last cell of the ray is what a shot hits, if it hits anything
+        auto [dr, dc] = DirectionUtils::toVector(static_cast<Direction>(f.facing));
+        const int steps = static_cast<int>(BoardScan::rayLength(board, row, col, dr, dc, CharSet("#@12")));
+        f.onTarget = shells > 0 && steps > 0 &&
+                     board[static_cast<int>(row) + steps * dr][static_cast<int>(col) + steps * dc] == enemy;
+        return f;
+    }
+
+    uint64_t key() const {
+        uint64_t k = 0;
+        for (int d = 0; d < 8; ++d) {
+            k |= static_cast<uint64_t>(ring[d]) << (3 * d);
+        }
+        k |= static_cast<uint64_t>(facing) << 24;
+        k |= static_cast<uint64_t>(enemyDirection) << 27;
+        k |= static_cast<uint64_t>(enemyRange) << 31;
+        k |= static_cast<uint64_t>(shells) << 33;
+        k |= static_cast<uint64_t>(onTarget) << 35;
+        return k;
+    }
+
+    // A decision as one word, never 0: the key, and the action + 1 in the top byte
+    static uint64_t pack(uint64_t key, ActionRequest action) {
+        return key | (static_cast<uint64_t>(action) + 1) << 56;
+    }
+    static uint64_t keyOf(uint64_t decision) { return decision & ((uint64_t{1} << 56) - 1); }
+    static ActionRequest actionOf(uint64_t decision) { return static_cast<ActionRequest>((decision >> 56) - 1); }
+
+private:
+    // The Direction whose 45 degree sector holds (dr, dc), which is not (0, 0)
+    static int sector(int dr, int dc) {
+        const int ar = std::abs(dr), ac = std::abs(dc);
+        const int sr = ac > 2 * ar ? 0 : (dr > 0) - (dr < 0);
+        const int sc = ar > 2 * ac ? 0 : (dc > 0) - (dc < 0);
+        for (int d = 0; d < 8; ++d) {
+            auto v = DirectionUtils::toVector(static_cast<Direction>(d));
+            if (v.first == sr && v.second == sc) {
+                return d;
+            }
+        }
+        return 0;
+    }
+};
+
+} // namespace UserCommon_212934582_323964676
+
+#endif // USERCOMMON_POLICYFEATURES_212934582_323964676_H
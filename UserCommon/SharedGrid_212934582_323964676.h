@@ -0,0 +1,52 @@
+// SharedGrid.h - Reference-counted, copy-on-write board snapshots
+#ifndef USERCOMMON_SHAREDGRID_212934582_323964676_H
+#define USERCOMMON_SHAREDGRID_212934582_323964676_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstddef>
+
+namespace UserCommon_212934582_323964676 {
+
+// A board as rows of characters: grid[row][col]
+using Grid = std::vector<std::string>;
+
+// An immutable board that any number of views, players and algorithms can share
+using GridSnapshot = std::shared_ptr<const Grid>;
+
+// Owner side of a shared board. snapshot() hands out the current grid without
+// copying it; the owner's next write clones the grid only while some snapshot
+// of it is still alive, so readers never see a board change under them.
+class SharedGrid {
+public:
+    SharedGrid() : grid_(std::make_shared<Grid>()) {}
+    explicit SharedGrid(Grid grid) : grid_(std::make_shared<Grid>(std::move(grid))) {}
+
+    const Grid& get() const { return *grid_; }
+    GridSnapshot snapshot() const { return grid_; }
+
+    char at(size_t row, size_t col) const { return (*grid_)[row][col]; }
+
+    // Write one cell; a no-op write never triggers a copy
+    void set(size_t row, size_t col, char c) {
+        if ((*grid_)[row][col] != c) {
+            mutate()[row][col] = c;
+        }
+    }
+
+    // Writable access to the whole grid, detached from all outstanding snapshots
+    Grid& mutate() {
+        if (grid_.use_count() > 1) {
+            grid_ = std::make_shared<Grid>(*grid_);
+        }
+        return *grid_;
+    }
+
+private:
+    std::shared_ptr<Grid> grid_;
+};
+
+} // namespace UserCommon_212934582_323964676
+
+#endif // USERCOMMON_SHAREDGRID_212934582_323964676_H
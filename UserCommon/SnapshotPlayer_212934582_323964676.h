@@ -0,0 +1,41 @@
+// SnapshotPlayer.h - A Player that gives its tanks the board and their position
+#ifndef USERCOMMON_SNAPSHOTPLAYER_212934582_323964676_H
+#define USERCOMMON_SNAPSHOTPLAYER_212934582_323964676_H
+
+#include "../common/Player.h"
+#include "../common/TankAlgorithm.h"
+#include "../common/SatelliteView.h"
+#include "MyBattleInfo_212934582_323964676.h"
+#include "BulkSatelliteView_212934582_323964676.h"
+#include <cstddef>
+
+namespace UserCommon_212934582_323964676 {
+
+// The player of the algorithms whose tanks track their own facing and shells
+// (see DeadReckoning) and need nothing else from it: every battle info is the
+// board, shared with the view when it offers a snapshot and copied only for
+// foreign views, the tank's own cell, and the initial shell count. A library
+// registers it under its own alias with REGISTER_PLAYER.
+class SnapshotPlayer : public Player {
+public:
+    SnapshotPlayer(int player_index, size_t /*x*/, size_t /*y*/, size_t /*max_steps*/, size_t num_shells)
+        : player_index_(player_index), num_shells_(num_shells) {}
+
+    void updateTankWithBattleInfo(TankAlgorithm& tank_algo, SatelliteView& satellite_view) override {
+        size_t tank_row = 0, tank_col = 0;
+        auto board = readSnapshot(satellite_view, static_cast<char>('0' + player_index_), tank_row, tank_col);
+        size_t height = board->size();
+        size_t width = height ? (*board)[0].size() : 0;
+
+        MyBattleInfo info(height, width, board, tank_row, tank_col, 0, num_shells_);
+        tank_algo.updateBattleInfo(info);
+    }
+
+private:
+    int player_index_;
+    size_t num_shells_;
+};
+
+} // namespace UserCommon_212934582_323964676
+
+#endif // USERCOMMON_SNAPSHOTPLAYER_212934582_323964676_H
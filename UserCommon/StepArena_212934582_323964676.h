@@ -0,0 +1,71 @@
+// StepArena.h - Monotonic scratch memory reset at step boundaries
+#ifndef USERCOMMON_STEPARENA_212934582_323964676_H
+#define USERCOMMON_STEPARENA_212934582_323964676_H
+
+#include <memory_resource>
+#include <memory>
+#include <optional>
+#include <cstddef>
+
+namespace UserCommon_212934582_323964676 {
+
+// Bump allocator for objects that all die together (one game step, one turn,
+// one decision). Allocations come from a buffer the arena owns; reset() frees
+// everything at once. A step that outgrows the buffer spills to the heap, and
+// the next reset() enlarges the buffer to cover it, so once the high-water mark
+// is reached the arena does no malloc/free at all. Not thread-safe: give every
+// game, player or algorithm its own arena.
+class StepArena {
+public:
+    explicit StepArena(size_t initial_bytes = 16 * 1024)
+        : capacity_(initial_bytes)
+        , buffer_(new std::byte[initial_bytes])
+    {
+        resource_.emplace(buffer_.get(), capacity_, &overflow_);
+    }
+
+    StepArena(const StepArena&) = delete;
+    StepArena& operator=(const StepArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &*resource_; }
+
+    // Free everything allocated since the last reset. Containers using the arena
+    // must be gone (or never touched again) before this is called.
+    void reset() {
+        resource_.reset();
+        if (overflow_.spilled > 0) {
+            capacity_ = 2 * (capacity_ + overflow_.spilled);
+            buffer_.reset(new std::byte[capacity_]);
+        }
+        overflow_.spilled = 0;
+        resource_.emplace(buffer_.get(), capacity_, &overflow_);
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    // Upstream of the monotonic resource; remembers how much did not fit
+    struct OverflowResource : std::pmr::memory_resource {
+        size_t spilled = 0;
+
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            spilled += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    size_t capacity_;
+    std::unique_ptr<std::byte[]> buffer_;
+    OverflowResource overflow_;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+};
+
+} // namespace UserCommon_212934582_323964676
+
+#endif // USERCOMMON_STEPARENA_212934582_323964676_H
@@ -0,0 +1,251 @@
+// ThreatMap.h - Per-cell danger from enemy firing lines and shells in flight
+#ifndef USERCOMMON_THREATMAP_212934582_323964676_H
+#define USERCOMMON_THREATMAP_212934582_323964676_H
+
+#include "Utils_212934582_323964676.h"
+#include "SharedGrid_212934582_323964676.h"
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace UserCommon_212934582_323964676 {
+
+// Which cells are dangerous to stand on, for the tanks of one player, built
+// once per update so that an algorithm can look each candidate move up in O(1):
+//  - lineDirections(r,c): bit d is set when an enemy tank could shoot the cell
+//    with a shot travelling in Direction d, by the engine's ray rule (a shot
+//    travels from the tank until the first wall, mine or tank, and hits that
+//    tank). Facing is not visible, so all 8 directions count. A shot is only
+//    allowed when it hits an enemy, so from such a cell we could shoot back,
+//    facing the opposite way. lines(r,c) counts the bits.
+//  - shellEta(r,c): the first of the next `horizon` steps on which a shell in
+//    flight ('*') could enter the cell. Shells advance one cell per step, before
+//    any tank acts, until a wall or a tank stops them; their direction is not
+//    visible either, so all 8 are assumed.
+//
+// Each of the 8 directions is one sweep over the grid carrying "a shot (or
+// shell) travelling this way reaches this cell" from each cell to the next, so
+// a build is O(cells) however many enemies and shells there are. Directions
+// with a downward or upward component take one row at a time from the row
+// before it, a loop over columns with no dependency between them.
+class ThreatMap {
+public:
+    static constexpr uint8_t NO_SHELL = UINT8_MAX;
+    static constexpr size_t MAX_HORIZON = NO_SHELL - 1;
+
+    ThreatMap() : rows_(0), cols_(0), horizon_(0) {}
+
+    // Recompute from board[row][col] for the tanks of `player` (1 or 2), with
+    // shells followed for `horizon` steps. The tank on (selfRow, selfCol), if
+    // given, does not block: it is the one deciding where to go.
+    void build(const Grid& board, int player, size_t horizon,
+               int selfRow = -1, int selfCol = -1) {
+        rows_ = board.size();
+        cols_ = rows_ ? board[0].size() : 0;
+        horizon_ = static_cast<uint8_t>(std::min(horizon, MAX_HORIZON));
+        lines_.assign(rows_ * cols_, 0);
+        range_.assign(rows_ * cols_, 0);
+        const bool shells = classify(board, player, selfRow, selfCol);
+
+        const size_t width = cols_ + 2;  // rows of kind_ and the sweep state have a zero column on each side
+        for (int k = 0; k < 3; ++k) {
+            lineState_[k].assign(width, 0);
+            rangeState_[k].assign(width, 0);
+            lineNext_[k].assign(width, 0);
+            rangeNext_[k].assign(width, 0);
+        }
+
+        // The engine fires shots instantly, so boards with shells on them are
+        // rare; without any the shell half of every sweep is skipped
+        if (shells) {
+            sweepAll<true>();
+        } else {
+            sweepAll<false>();
+        }
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t horizon() const { return horizon_; }
+
+    uint8_t lineDirections(size_t row, size_t col) const { return lines_[row * cols_ + col]; }
+    int lines(size_t row, size_t col) const {
+        int count = 0;
+        for (uint8_t bits = lines_[row * cols_ + col]; bits; bits &= static_cast<uint8_t>(bits - 1)) {
+            ++count;
+        }
+        return count;
+    }
+    uint8_t shellEta(size_t row, size_t col) const {
+        uint8_t range = range_[row * cols_ + col];
+        return range ? static_cast<uint8_t>(horizon_ + 1 - range) : NO_SHELL;
+    }
+
+    // No enemy line and no shell within the horizon
+    bool safe(size_t row, size_t col) const {
+        size_t i = row * cols_ + col;
+        return lines_[i] == 0 && range_[i] == 0;
+    }
+
+private:
+    // What a cell does to a shot or shell leaving it
+    enum Kind : uint8_t {
+        ENEMY      = 1,  // an enemy tank: shots start here
+        LINE_OPEN  = 2,  // shots pass through
+        SHELL      = 4,  // a shell is here now
+        SHELL_OPEN = 8,  // shells pass through (mines do not stop them)
+    };
+
+    size_t rows_, cols_;
+    uint8_t horizon_;
+    std::vector<uint8_t> lines_;  // lineDirections per cell
+    std::vector<uint8_t> range_;  // per cell, horizon + 1 - shellEta, or 0 when no shell comes
+    std::vector<uint8_t> kind_;  // (cols_ + 2) per row, padded with zeros
+
+    // Sweep state for the three directions of one vertical pass (column step
+    // -1, 0, +1), as it stands on the row just processed and on the next one
+    std::vector<uint8_t> lineState_[3], rangeState_[3];
+    std::vector<uint8_t> lineNext_[3], rangeNext_[3];
+
+    // Fills kind_; returns whether there is any shell on the board
+    bool classify(const Grid& board, int player, int selfRow, int selfCol) {
+        const size_t width = cols_ + 2;
+        const char enemy = player == 1 ? '2' : '1';
+        std::array<uint8_t, 256> kindOf;
+        for (int ch = 0; ch < 256; ++ch) {
+            uint8_t k = 0;
+            if (ch == enemy) {
+                k = ENEMY;
+            } else if (ch != '#' && ch != '1' && ch != '2') {
+                k = SHELL_OPEN;
+                if (ch != '@') k |= LINE_OPEN;
+                if (ch == '*') k |= SHELL;
+            }
+            kindOf[ch] = k;
+        }
+        kind_.assign(rows_ * width, 0);
+        uint8_t any = 0;
+        for (size_t r = 0; r < rows_; ++r) {
+            const std::string& line = board[r];
+            const size_t n = std::min(cols_, line.size());
+            uint8_t* out = &kind_[r * width + 1];
+            for (size_t c = 0; c < n; ++c) {
+                out[c] = kindOf[static_cast<unsigned char>(line[c])];
+                any |= out[c];
+            }
+        }
+        if (selfRow >= 0 && selfCol >= 0 && static_cast<size_t>(selfRow) < rows_ && static_cast<size_t>(selfCol) < cols_) {
+            kind_[selfRow * width + selfCol + 1] = kindOf[' '];
+        }
+        return (any & SHELL) != 0;
+    }
+
+    // Bit for shots travelling (dr, dc)
+    static uint8_t directionBit(int dr, int dc) {
+        for (int d = 0; d < 8; ++d) {
+            if (DirectionUtils::toVector(static_cast<Direction>(d)) == std::make_pair(dr, dc)) {
+                return static_cast<uint8_t>(1u << d);
+            }
+        }
+        return 0;
+    }
+
+    // One step of a sweep: the state a cell gets from the cell before it, of
+    // kind `from` with state (line, range). A shell has `horizon` steps of range
+    // left on the cell next to it and one fewer on each cell after that. Free
+    // of branches and of members, so the loops over a row can be vectorised.
+    static uint8_t nextLine(uint8_t from, uint8_t line) {
+        uint8_t open = static_cast<uint8_t>(-((from & LINE_OPEN) >> 1));
+        return static_cast<uint8_t>((from & ENEMY) | (line & open));
+    }
+    static uint8_t nextRange(uint8_t from, uint8_t range, uint8_t horizon) {
+        uint8_t shell = static_cast<uint8_t>(-((from & SHELL) >> 2));
+        uint8_t open = static_cast<uint8_t>(-((from & SHELL_OPEN) >> 3));
+        uint8_t left = static_cast<uint8_t>(range - (range != 0));
+        return static_cast<uint8_t>((shell & horizon) | (~shell & open & left));
+    }
+
+    template <bool Shells>
+    void sweepAll() {
+        // Shots and shells travelling down (DOWN_LEFT, DOWN, DOWN_RIGHT), then up
+        sweepVertical<Shells>(+1);
+        sweepVertical<Shells>(-1);
+        // Along each row, both ways
+        for (size_t r = 0; r < rows_; ++r) {
+            sweepRow<Shells>(r, +1);
+            sweepRow<Shells>(r, -1);
+        }
+    }
+
+    // dr = +1 sweeps top to bottom for shots travelling down; -1 the reverse
+    template <bool Shells>
+    void sweepVertical(int dr) {
+        const size_t width = cols_ + 2;
+        const size_t cols = cols_;
+        const uint8_t horizon = horizon_;
+        for (int k = 0; k < 3; ++k) {
+            std::fill(lineState_[k].begin(), lineState_[k].end(), 0);
+            std::fill(rangeState_[k].begin(), rangeState_[k].end(), 0);
+        }
+        const uint8_t bits[3] = { directionBit(dr, -1), directionBit(dr, 0), directionBit(dr, 1) };
+        for (size_t i = 1; i < rows_; ++i) {
+            size_t r = dr > 0 ? i : rows_ - 1 - i;
+            const uint8_t* from = &kind_[(dr > 0 ? r - 1 : r + 1) * width];
+            for (size_t k = 0; k < 3; ++k) {
+                const uint8_t* line = lineState_[k].data();
+                const uint8_t* range = rangeState_[k].data();
+                uint8_t* lineOut = lineNext_[k].data();
+                uint8_t* rangeOut = rangeNext_[k].data();
+                // Padded cell c is reached from padded cell c - (k - 1)
+                for (size_t c = 1; c <= cols; ++c) {
+                    size_t p = c + 1 - k;
+                    lineOut[c] = nextLine(from[p], line[p]);
+                    if (Shells) rangeOut[c] = nextRange(from[p], range[p], horizon);
+                }
+                lineState_[k].swap(lineNext_[k]);
+                if (Shells) rangeState_[k].swap(rangeNext_[k]);
+            }
+            const uint8_t* line0 = lineState_[0].data() + 1;
+            const uint8_t* line1 = lineState_[1].data() + 1;
+            const uint8_t* line2 = lineState_[2].data() + 1;
+            const uint8_t* range0 = rangeState_[0].data() + 1;
+            const uint8_t* range1 = rangeState_[1].data() + 1;
+            const uint8_t* range2 = rangeState_[2].data() + 1;
+            uint8_t* lines = &lines_[r * cols];
+            uint8_t* ranges = &range_[r * cols];
+            for (size_t c = 0; c < cols; ++c) {
+                lines[c] = static_cast<uint8_t>(lines[c] | (line0[c] * bits[0]) | (line1[c] * bits[1]) | (line2[c] * bits[2]));
+                if (Shells) ranges[c] = std::max({ ranges[c], range0[c], range1[c], range2[c] });
+            }
+        }
+    }
+
+    // dc = +1 sweeps row r left to right for shots travelling right; -1 the reverse
+    template <bool Shells>
+    void sweepRow(size_t r, int dc) {
+        const size_t cols = cols_;
+        const uint8_t horizon = horizon_;
+        const uint8_t* kinds = &kind_[r * (cols + 2) + 1];
+        uint8_t* lines = &lines_[r * cols];
+        uint8_t* ranges = &range_[r * cols];
+        const uint8_t bit = directionBit(0, dc);
+        uint8_t line = 0, range = 0;
+        for (size_t i = 1; i < cols; ++i) {
+            size_t c = dc > 0 ? i : cols - 1 - i;
+            uint8_t from = kinds[dc > 0 ? c - 1 : c + 1];
+            line = nextLine(from, line);
+            lines[c] = static_cast<uint8_t>(lines[c] | (line * bit));
+            if (Shells) {
+                range = nextRange(from, range, horizon);
+                ranges[c] = std::max(ranges[c], range);
+            }
+        }
+    }
+};
+
+} // namespace UserCommon_212934582_323964676
+
+#endif // USERCOMMON_THREATMAP_212934582_323964676_H
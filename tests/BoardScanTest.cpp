@@ -0,0 +1,137 @@
+#include "simple_test.h"
+#include "../UserCommon/BoardScan_212934582_323964676.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using UserCommon_212934582_323964676::BoardScan;
+using UserCommon_212934582_323964676::CharSet;
+using UserCommon_212934582_323964676::Grid;
+
+namespace UserCommon_212934582_323964676 {
+
+// Every kernel of this build, by name, next to the scalar loops
+class BoardScanTest {
+public:
+    struct Kernels {
+        const char* name;
+        size_t (*findFirst)(const char*, size_t, const CharSet&);
+        size_t (*findLast)(const char*, size_t, const CharSet&);
+        void (*markMembers)(const char*, size_t, const CharSet&, uint8_t*);
+    };
+
+    static std::vector<Kernels> kernels() {
+        std::vector<Kernels> all{{"dispatched", BoardScan::findFirst, BoardScan::findLast, BoardScan::markMembers}};
+#ifdef USERCOMMON_BOARDSCAN_X86
+        all.push_back({"sse2", BoardScan::findFirstSse2, BoardScan::findLastSse2, BoardScan::markMembersSse2});
+        if (BoardScan::hasAvx2()) {
+            all.push_back({"avx2", BoardScan::findFirstAvx2, BoardScan::findLastAvx2, BoardScan::markMembersAvx2});
+        }
+#endif
+        return all;
+    }
+
+    static size_t findFirstScalar(const char* data, size_t n, const CharSet& set) {
+        return BoardScan::findFirstScalar(data, n, set, 0);
+    }
+    static size_t findLastScalar(const char* data, size_t n, const CharSet& set) {
+        return BoardScan::findLastScalar(data, n, set, n);
+    }
+    static void markMembersScalar(const char* data, size_t n, const CharSet& set, uint8_t* out) {
+        BoardScan::markMembersScalar(data, n, set, out, 0);
+    }
+};
+
+} // namespace UserCommon_212934582_323964676
+
+using UserCommon_212934582_323964676::BoardScanTest;
+
+namespace {
+
+const char BOARD_CHARS[] = " #@12*$%";
+
+// A run of board characters, mostly blank so that matches are sparse
+std::string randomRow(std::mt19937& rng, size_t n) {
+    std::uniform_int_distribution<int> pick(0, 40);
+    std::string row(n, ' ');
+    for (char& ch : row) {
+        int k = pick(rng);
+        ch = k < 8 ? BOARD_CHARS[k] : ' ';
+    }
+    return row;
+}
+
+} // namespace
+
+// Every kernel finds what the scalar loops find, for every length around the
+// 16- and 32-byte blocks, at unaligned starts, and for sets of 1 to MAX_CHARS
+TEST(board_scan_kernels_match_scalar) {
+    std::mt19937 rng(39);
+    const CharSet sets[] = {CharSet("2"), CharSet("#@12"), CharSet("@"), CharSet("0123456789#@"),
+                            CharSet("abcdefghijklmnop"), CharSet()};
+    for (const auto& kernel : BoardScanTest::kernels()) {
+        size_t mismatches = 0;
+        for (size_t n = 0; n <= 100; ++n) {
+            for (size_t offset = 0; offset < 4; ++offset) {
+                const std::string row = randomRow(rng, n + offset);
+                const char* data = row.data() + offset;
+                for (const auto& set : sets) {
+                    if (kernel.findFirst(data, n, set) != BoardScanTest::findFirstScalar(data, n, set)) ++mismatches;
+                    if (kernel.findLast(data, n, set) != BoardScanTest::findLastScalar(data, n, set)) ++mismatches;
+
+                    std::vector<uint8_t> marks(n + 1, 7), expected(n + 1, 7);
+                    kernel.markMembers(data, n, set, marks.data());
+                    BoardScanTest::markMembersScalar(data, n, set, expected.data());
+                    if (marks != expected) ++mismatches;  // including the byte past the end
+                }
+            }
+        }
+        if (mismatches) std::cerr << kernel.name << " kernels:" << std::endl;
+        CHECK_EQ(mismatches, size_t{0});
+    }
+}
+
+// forEach visits exactly the members, in order
+TEST(board_scan_for_each_visits_members) {
+    std::mt19937 rng(40);
+    const CharSet set("#@");
+    for (size_t n : {0, 1, 15, 16, 17, 33, 64, 257}) {
+        const std::string row = randomRow(rng, n);
+        std::vector<size_t> visited, expected;
+        BoardScan::forEach(row.data(), n, set, [&](size_t i) { visited.push_back(i); });
+        for (size_t i = 0; i < n; ++i) {
+            if (set.contains(row[i])) expected.push_back(i);
+        }
+        CHECK(visited == expected);
+    }
+}
+
+// rayLength, vectorised along rows, walks as far as a shot does cell by cell
+TEST(board_scan_ray_length_matches_walk) {
+    std::mt19937 rng(41);
+    const CharSet stop("#@12");
+    Grid board;
+    for (size_t r = 0; r < 23; ++r) board.push_back(randomRow(rng, 70));
+
+    size_t mismatches = 0;
+    for (size_t r = 0; r < board.size(); ++r) {
+        for (size_t c = 0; c < board[r].size(); ++c) {
+            for (int dr = -1; dr <= 1; ++dr) {
+                for (int dc = -1; dc <= 1; ++dc) {
+                    if (dr == 0 && dc == 0) continue;
+                    size_t walked = 0;
+                    for (long rr = static_cast<long>(r) + dr, cc = static_cast<long>(c) + dc;
+                         rr >= 0 && rr < static_cast<long>(board.size()) && cc >= 0 &&
+                         cc < static_cast<long>(board[rr].size());
+                         rr += dr, cc += dc) {
+                        ++walked;
+                        if (stop.contains(board[rr][cc])) break;
+                    }
+                    if (BoardScan::rayLength(board, r, c, dr, dc, stop) != walked) ++mismatches;
+                }
+            }
+        }
+    }
+    CHECK_EQ(mismatches, size_t{0});
+}
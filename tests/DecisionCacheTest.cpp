@@ -0,0 +1,47 @@
+#include "simple_test.h"
+#include "../Algorithm/DecisionCache_212934582_323964676.h"
+#include <thread>
+#include <vector>
+
+using Algorithm_212934582_323964676::DecisionCache_212934582_323964676;
+using Key = DecisionCache_212934582_323964676::Key;
+
+namespace {
+
+Key keyOf(uint32_t state) {
+    return Key{0x1234, 10, 20, state, 1};
+}
+
+} // namespace
+
+TEST(decision_cache_counts_hits_and_misses) {
+    DecisionCache_212934582_323964676 cache(1024);
+    ActionRequest action = ActionRequest::DoNothing;
+    CHECK(!cache.find(keyOf(7), action));
+    cache.store(keyOf(7), ActionRequest::Shoot);
+    CHECK(cache.find(keyOf(7), action));
+    CHECK(action == ActionRequest::Shoot);
+    CHECK(!cache.find(keyOf(8), action));
+    CHECK_EQ(cache.hits(), 1u);
+    CHECK_EQ(cache.misses(), 2u);
+}
+
+// Every lookup of every thread is counted once, whichever stripe it lands in
+TEST(decision_cache_counts_every_lookup_across_threads) {
+    DecisionCache_212934582_323964676 cache(1024);
+    const uint32_t KEYS = 256;
+    for (uint32_t state = 0; state < KEYS; state += 2) {
+        cache.store(keyOf(state), ActionRequest::MoveForward);
+    }
+    const int THREADS = 4;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&cache] {
+            ActionRequest action;
+            for (uint32_t state = 0; state < KEYS; ++state) cache.find(keyOf(state), action);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    CHECK_EQ(cache.hits() + cache.misses(), static_cast<uint64_t>(THREADS) * KEYS);
+    CHECK(cache.hits() <= static_cast<uint64_t>(THREADS) * KEYS / 2);
+}
@@ -0,0 +1,37 @@
+// An algorithm library whose tanks fail on their first action, for the tests
+// of -isolated: built once with FAULTY_TANK_SPIN (the tank never returns) and
+// once without (it crashes the process)
+#include "../common/Player.h"
+#include "../common/PlayerRegistration.h"
+#include "../common/TankAlgorithm.h"
+#include "../common/TankAlgorithmRegistration.h"
+#include <csignal>
+
+namespace {
+
+class FaultyPlayer : public Player {
+public:
+    FaultyPlayer(int, size_t, size_t, size_t, size_t) {}
+    void updateTankWithBattleInfo(TankAlgorithm&, SatelliteView&) override {}
+};
+
+class FaultyTank : public TankAlgorithm {
+public:
+    FaultyTank(int, int) {}
+
+    ActionRequest getAction() override {
+#ifdef FAULTY_TANK_SPIN
+        for (volatile unsigned long spin = 0;; spin = spin + 1) {}
+#else
+        std::raise(SIGSEGV);
+        return ActionRequest::DoNothing;
+#endif
+    }
+
+    void updateBattleInfo(BattleInfo&) override {}
+};
+
+} // namespace
+
+REGISTER_PLAYER(FaultyPlayer)
+REGISTER_TANK_ALGORITHM(FaultyTank)
@@ -0,0 +1,316 @@
+#include "simple_test.h"
+#include "../Algorithm/FiringDistanceField_212934582_323964676.h"
+#include "../UserCommon/ChangeJournal_212934582_323964676.h"
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using UserCommon_212934582_323964676::CellChange;
+using UserCommon_212934582_323964676::Grid;
+using UserCommon_212934582_323964676::GridSnapshot;
+using UserCommon_212934582_323964676::MoveMaskGrid;
+using Algorithm_212934582_323964676::Direction;
+using Algorithm_212934582_323964676::DirectionUtils;
+using Field = Algorithm_212934582_323964676::FiringDistanceField_212934582_323964676;
+
+namespace Algorithm_212934582_323964676 {
+
+// Reaches into a field for what its public interface does not show
+class FiringDistanceFieldTest {
+public:
+    // Whether the field is kept up to date by repairs: true after an update
+    // with a change list, until a repair gives up
+    static bool repairable(const Field& field) { return field._fieldValid; }
+
+    // The first action searchForward() takes from (r, c, d) with breadth-first
+    // search (bounded false) or with A* (bounded true), whichever it would
+    // have picked
+    static ActionRequest searchForward(Field& field, int r, int c, Direction d, bool bounded) {
+        field._searches = 0;  // not a probe of the other search
+        field._breadthFirstCost = bounded ? SIZE_MAX : 0;
+        field._boundedSearchCost = bounded ? 0 : SIZE_MAX / 2;
+        return field.searchForward(static_cast<uint32_t>((r * static_cast<int>(field._cols) + c) * 8 + static_cast<int>(d)));
+    }
+
+    static bool hierarchical(const Field& field) { return field._analysis && field._analysis->clusters(); }
+};
+
+} // namespace Algorithm_212934582_323964676
+
+using Algorithm_212934582_323964676::FiringDistanceFieldTest;
+
+namespace {
+
+// A random rows x cols map for player 1: walls, a few mines, two tanks of its
+// own and three enemies
+Grid randomBoard(std::mt19937& rng, size_t rows, size_t cols) {
+    Grid board(rows, std::string(cols, ' '));
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (auto& line : board) {
+        for (char& cell : line) {
+            int p = percent(rng);
+            cell = p < 18 ? '#' : p < 21 ? '@' : ' ';
+        }
+    }
+    std::uniform_int_distribution<size_t> row(0, rows - 1), col(0, cols - 1);
+    for (char tank : std::string("11222")) {
+        board[row(rng)][col(rng)] = tank;
+    }
+    return board;
+}
+
+// One turn of a game on `board`, recorded in `changes`: every tank steps to a
+// random neighbouring cell that holds no wall or tank (dying on a mine, which
+// goes with it), and a random wall may fall
+void playTurn(std::mt19937& rng, Grid& board, std::pmr::vector<CellChange>& changes) {
+    const size_t rows = board.size(), cols = board[0].size();
+    auto set = [&](size_t r, size_t c, char cell) {
+        board[r][c] = cell;
+        changes.emplace_back(static_cast<uint32_t>(r), static_cast<uint32_t>(c), cell);
+    };
+
+    std::vector<std::pair<size_t, size_t>> tanks;
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            if (board[r][c] == '1' || board[r][c] == '2') tanks.emplace_back(r, c);
+        }
+    }
+    std::uniform_int_distribution<int> step(-1, 1);
+    for (auto [r, c] : tanks) {
+        const int nr = static_cast<int>(r) + step(rng), nc = static_cast<int>(c) + step(rng);
+        if (nr < 0 || nc < 0 || nr >= static_cast<int>(rows) || nc >= static_cast<int>(cols)) continue;
+        const char target = board[nr][nc];
+        if (target != ' ' && target != '@') continue;
+        const char tank = board[r][c];
+        set(r, c, ' ');
+        set(nr, nc, target == '@' ? ' ' : tank);
+    }
+
+    std::uniform_int_distribution<size_t> row(0, rows - 1), col(0, cols - 1);
+    const size_t r = row(rng), c = col(rng);
+    if (board[r][c] == '#') set(r, c, ' ');
+}
+
+// States (r, c, d) of the empty cells on which the two fields choose different actions
+size_t disagreements(Field& a, Field& b, const Grid& board) {
+    size_t count = 0;
+    for (size_t r = 0; r < board.size(); ++r) {
+        for (size_t c = 0; c < board[r].size(); ++c) {
+            if (board[r][c] != ' ') continue;
+            for (int d = 0; d < 8; ++d) {
+                const auto dir = static_cast<Algorithm_212934582_323964676::Direction>(d);
+                if (a.nextAction(static_cast<int>(r), static_cast<int>(c), dir) !=
+                    b.nextAction(static_cast<int>(r), static_cast<int>(c), dir)) {
+                    ++count;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+// A field repaired from each turn's changes answers every state as one rebuilt
+// from the whole board does
+TEST(field_repair_matches_rebuild) {
+    std::mt19937 rng(2025);
+    for (int game = 0; game < 4; ++game) {
+        Grid board = randomBoard(rng, 18, 24);
+        Field repaired(1);
+        repaired.update(std::make_shared<const Grid>(board), nullptr, nullptr);
+
+        int repairs = 0;
+        const int turns = 30;
+        for (int turn = 0; turn < turns; ++turn) {
+            std::pmr::vector<CellChange> changes;
+            playTurn(rng, board, changes);
+            auto snapshot = std::make_shared<const Grid>(board);
+            repaired.update(snapshot, nullptr, &changes);
+            const bool repairable = FiringDistanceFieldTest::repairable(repaired);
+
+            Field rebuilt(1);
+            rebuilt.update(snapshot, nullptr, nullptr);
+            CHECK_EQ(repaired.boardHash(), rebuilt.boardHash());
+            CHECK_EQ(disagreements(repaired, rebuilt, board), size_t{0});
+            if (repairable && FiringDistanceFieldTest::repairable(repaired)) ++repairs;
+        }
+        // Most turns change a handful of cells: the field must not fall back
+        // to searching or rebuilding on them
+        CHECK(repairs > turns / 2);
+    }
+}
+
+// An update that cannot say what changed starts the field over
+TEST(field_update_without_changes_rebuilds) {
+    std::mt19937 rng(7);
+    Grid board = randomBoard(rng, 12, 12);
+    Field field(2);
+    field.update(std::make_shared<const Grid>(board), nullptr, nullptr);
+    field.nextAction(0, 0, Algorithm_212934582_323964676::Direction::UP);
+    CHECK(FiringDistanceFieldTest::repairable(field));
+
+    std::pmr::vector<CellChange> changes;
+    playTurn(rng, board, changes);
+    field.update(std::make_shared<const Grid>(board), nullptr, nullptr);
+    CHECK(!FiringDistanceFieldTest::repairable(field));
+}
+
+namespace {
+
+// (r, c, d) after `action`; moves are taken only where `masks` allow them
+struct TankState {
+    int r, c;
+    Direction d;
+};
+
+bool apply(TankState& tank, ActionRequest action, const MoveMaskGrid& masks) {
+    switch (action) {
+        case ActionRequest::RotateLeft45:  tank.d = DirectionUtils::rotate45ccw(tank.d); return true;
+        case ActionRequest::RotateRight45: tank.d = DirectionUtils::rotate45cw(tank.d); return true;
+        case ActionRequest::RotateLeft90:  tank.d = DirectionUtils::rotate90(tank.d, false); return true;
+        case ActionRequest::RotateRight90: tank.d = DirectionUtils::rotate90(tank.d, true); return true;
+        case ActionRequest::MoveForward:
+        case ActionRequest::MoveBackward: {
+            const Direction way = action == ActionRequest::MoveForward ? tank.d : DirectionUtils::rotate180(tank.d);
+            if (!masks.canMove(tank.r, tank.c, way)) return false;
+            auto [dr, dc] = DirectionUtils::toVector(way);
+            tank.r += dr;
+            tank.c += dc;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// Fewest actions from `start` to a state from which `field` can shoot, by a
+// breadth-first search of its own over the same moves; -1 when there is none
+int shortestPath(const Field& field, const MoveMaskGrid& masks, size_t rows, size_t cols, TankState start) {
+    const ActionRequest actions[] = {ActionRequest::RotateLeft45, ActionRequest::RotateRight45,
+                                     ActionRequest::RotateLeft90, ActionRequest::RotateRight90,
+                                     ActionRequest::MoveForward, ActionRequest::MoveBackward};
+    auto index = [&](const TankState& s) { return (static_cast<size_t>(s.r) * cols + s.c) * 8 + static_cast<size_t>(s.d); };
+    std::vector<int> dist(rows * cols * 8, -1);
+    std::vector<TankState> queue{start};
+    dist[index(start)] = 0;
+    for (size_t i = 0; i < queue.size(); ++i) {
+        const TankState s = queue[i];
+        if (field.canShootFrom(s.r, s.c, s.d)) return dist[index(s)];
+        for (ActionRequest action : actions) {
+            TankState next = s;
+            if (apply(next, action, masks) && dist[index(next)] < 0) {
+                dist[index(next)] = dist[index(s)] + 1;
+                queue.push_back(next);
+            }
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+// Breadth-first search, A* and the distance field all take the first action
+// of the same path: of the shortest ones, the one whose first action comes
+// first in successor order (its rank)
+TEST(search_breadth_first_bounded_and_field_agree) {
+    std::mt19937 rng(40);
+    for (int game = 0; game < 3; ++game) {
+        const Grid board = randomBoard(rng, 16 + 4 * game, 22);
+        auto snapshot = std::make_shared<const Grid>(board);
+        Field searched(1), field(1);
+        searched.update(snapshot, nullptr, nullptr);
+        field.update(snapshot, nullptr, nullptr);
+
+        size_t states = 0, breadthFirstOff = 0, boundedOff = 0;
+        for (int r = 0; r < static_cast<int>(board.size()); ++r) {
+            for (int c = 0; c < static_cast<int>(board[r].size()); ++c) {
+                if (board[r][c] != ' ') continue;
+                for (int d = 0; d < 8; ++d) {
+                    const auto dir = static_cast<Direction>(d);
+                    if (field.canShootFrom(r, c, dir)) continue;  // nothing to search for
+                    const ActionRequest expected = field.nextAction(r, c, dir);
+                    ++states;
+                    if (FiringDistanceFieldTest::searchForward(searched, r, c, dir, false) != expected) ++breadthFirstOff;
+                    if (FiringDistanceFieldTest::searchForward(searched, r, c, dir, true) != expected) ++boundedOff;
+                }
+            }
+        }
+        CHECK(states > 0);
+        CHECK_EQ(breadthFirstOff, size_t{0});
+        CHECK_EQ(boundedOff, size_t{0});
+    }
+}
+
+// On a map with a ClusterGraph every tank is routed hierarchically: each
+// action it is given is legal, and following them reaches a firing state on a
+// path that is short, if not always the shortest
+TEST(search_hierarchical_reaches_a_firing_state) {
+    std::mt19937 rng(41);
+    const size_t rows = 512, cols = 520;  // above ClusterGraph::MIN_CELLS
+    Grid board(rows, std::string(cols, ' '));
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (auto& line : board) {
+        for (char& cell : line) {
+            if (percent(rng) < 12) cell = '#';
+        }
+    }
+    // A wall across most of the map, with the enemy on the other side of it
+    for (size_t c = 0; c + 40 < cols; ++c) board[rows / 2][c] = '#';
+    board[rows / 2 + 10][cols - 150] = '2';
+    const TankState starts[] = {{static_cast<int>(rows / 2 - 10), static_cast<int>(cols - 150), Direction::UP},
+                                {static_cast<int>(rows / 2 + 80), static_cast<int>(cols - 260), Direction::LEFT}};
+    for (const TankState& start : starts) {
+        board[start.r][start.c] = ' ';
+    }
+    auto snapshot = std::make_shared<const Grid>(board);
+    Field field(1);
+    field.update(snapshot, nullptr, nullptr);
+    CHECK(FiringDistanceFieldTest::hierarchical(field));
+
+    MoveMaskGrid masks;
+    masks.build(board, rows, cols, /*corner_cut=*/true);
+    for (const TankState& start : starts) {
+        const int shortest = shortestPath(field, masks, rows, cols, start);
+        CHECK(shortest > 0);
+
+        // Short: the coarse search weighs its bound ROUTE_WEIGHT (2) times,
+        // and the walk may take no more than twice the shortest path
+        TankState tank = start;
+        int actions = 0;
+        bool legal = true;
+        while (!field.canShootFrom(tank.r, tank.c, tank.d) && actions <= 2 * shortest && legal) {
+            legal = apply(tank, field.nextAction(tank.r, tank.c, tank.d), masks);
+            ++actions;
+        }
+        CHECK(legal);
+        CHECK(field.canShootFrom(tank.r, tank.c, tank.d));
+    }
+}
+
+// Games that meet a new layout at once share one analysis of it: the first
+// builds it and the others wait for that build
+TEST(search_layout_analysed_once_for_concurrent_games) {
+    using Analysis = Algorithm_212934582_323964676::StaticMapAnalysis_212934582_323964676;
+    std::mt19937 rng(42);
+    const Grid board = randomBoard(rng, 300, 300);
+    const Grid other = randomBoard(rng, 300, 300);
+
+    const size_t THREADS = 8;
+    std::vector<std::shared_ptr<const Analysis>> analyses(THREADS);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] { analyses[t] = Analysis::forBoard(t % 4 == 3 ? other : board); });
+    }
+    for (auto& thread : threads) thread.join();
+    for (size_t t = 0; t < THREADS; ++t) {
+        CHECK(analyses[t] != nullptr);
+        CHECK(analyses[t] == analyses[t % 4 == 3 ? 3 : 0]);
+    }
+    CHECK(analyses[0] != analyses[3]);
+    CHECK(Analysis::forBoard(board) == analyses[0]);
+}
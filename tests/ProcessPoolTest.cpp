@@ -0,0 +1,83 @@
+#include "simple_test.h"
+#include "../Simulator/ProcessPool.h"
+#include <csignal>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const size_t JOBS = 8;
+
+std::vector<size_t> inOrder() {
+    std::vector<size_t> order(JOBS);
+    std::iota(order.begin(), order.end(), 0);
+    return order;
+}
+
+// Plays job j as a game won by player j % 2 + 1 in j rounds, except for `bad`,
+// which does `fault`
+template <typename Fault>
+ProcessPool::Job playing(size_t bad, Fault fault) {
+    return [bad, fault](size_t job, GameOutcome& outcome) {
+        if (job == bad) fault();
+        outcome.winner = static_cast<int32_t>(job % 2 + 1);
+        outcome.rounds = job;
+        return true;
+    };
+}
+
+// Every job but `bad` came back as played
+bool othersPlayed(const std::vector<GameOutcome>& outcomes, size_t bad) {
+    for (size_t job = 0; job < outcomes.size(); ++job) {
+        if (job == bad) continue;
+        const GameOutcome& outcome = outcomes[job];
+        if (outcome.state != GameOutcome::PLAYED || outcome.rounds != job ||
+            outcome.winner != static_cast<int32_t>(job % 2 + 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(process_pool_plays_every_job) {
+    const auto outcomes = ProcessPool::run(JOBS, inOrder(), 3, {}, playing(JOBS, [] {}));
+    CHECK_EQ(outcomes.size(), JOBS);
+    CHECK(othersPlayed(outcomes, JOBS));
+}
+
+// A job that kills its worker is reported with the signal, and a new worker
+// plays the jobs that were left
+TEST(process_pool_reports_a_crashed_worker) {
+    const size_t bad = 3;
+    const auto outcomes = ProcessPool::run(JOBS, inOrder(), 2, {}, playing(bad, [] { std::raise(SIGSEGV); }));
+    CHECK_EQ(outcomes[bad].state, GameOutcome::CRASHED);
+    CHECK_EQ(outcomes[bad].signal, SIGSEGV);
+    CHECK(ProcessPool::describeFailure(outcomes[bad]).find("killed its worker") == 0);
+    CHECK(othersPlayed(outcomes, bad));
+}
+
+// A job that runs past worker_cpu_seconds is stopped by SIGXCPU
+TEST(process_pool_stops_a_job_over_its_cpu_limit) {
+    const size_t bad = 0;
+    ProcessPool::Limits limits;
+    limits.cpu_seconds = 1;
+    const auto outcomes = ProcessPool::run(JOBS, inOrder(), 2, limits, playing(bad, [] {
+        for (volatile unsigned long spin = 0;; spin = spin + 1) {}
+    }));
+    CHECK_EQ(outcomes[bad].state, GameOutcome::CRASHED);
+    CHECK_EQ(outcomes[bad].signal, SIGXCPU);
+    CHECK_EQ(ProcessPool::describeFailure(outcomes[bad]), std::string("exceeded its CPU time limit"));
+    CHECK(othersPlayed(outcomes, bad));
+}
+
+// A job that throws fails alone; its worker goes on
+TEST(process_pool_reports_a_throwing_job) {
+    const size_t bad = 5;
+    const auto outcomes = ProcessPool::run(JOBS, inOrder(), 1, {}, playing(bad, [] { throw std::runtime_error("bad game"); }));
+    CHECK_EQ(outcomes[bad].state, GameOutcome::CRASHED);
+    CHECK_EQ(outcomes[bad].signal, 0);
+    CHECK(othersPlayed(outcomes, bad));
+}
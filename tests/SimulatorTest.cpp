@@ -0,0 +1,176 @@
+#include "simple_test.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// A fresh, empty folder of the scratch area
+fs::path scratch(const std::string& name) {
+    fs::path folder = fs::path(SCRATCH_FOLDER) / name;
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+    return folder;
+}
+
+// Copy `library` into `folder` as `name`.so
+std::string install(const std::string& library, const fs::path& folder, const std::string& name) {
+    fs::path target = folder / (name + ".so");
+    fs::copy_file(library, target, fs::copy_options::overwrite_existing);
+    return target.string();
+}
+
+std::string readFile(const fs::path& path) {
+    std::ifstream in(path);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+// Run the simulator with `arguments`; its exit status, and what it printed in `output`
+int simulate(const std::string& arguments, std::string& output) {
+    const fs::path log = fs::path(SCRATCH_FOLDER) / "simulator.log";
+    const std::string command = std::string("\"") + SIMULATOR_BINARY + "\" " + arguments + " > \"" +
+                                log.string() + "\" 2>&1";
+    const int status = std::system(command.c_str());
+    output = readFile(log);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// The one result file (.txt) of `folder` whose name starts with `prefix`, or
+// an empty path when there is none or more than one
+fs::path resultFile(const fs::path& folder, const std::string& prefix) {
+    fs::path found;
+    int count = 0;
+    for (const auto& entry : fs::directory_iterator(folder)) {
+        if (entry.path().extension() == ".txt" && entry.path().filename().string().rfind(prefix, 0) == 0) {
+            found = entry.path();
+            ++count;
+        }
+    }
+    return count == 1 ? found : fs::path();
+}
+
+// A comparative run of Aggressive against `opponent` on input1.txt, in
+// isolated workers with `limits`; what the simulator printed
+std::string isolatedAgainst(const std::string& opponent, const std::string& limits, int& status) {
+    const fs::path run = scratch("isolated");
+    const fs::path managers = run / "game_managers";
+    fs::create_directories(managers);
+    install(GAME_MANAGER_LIBRARY, managers, "GameManager");
+    const std::string aggressive = install(AGGRESSIVE_LIBRARY, run, "Aggressive");
+    const std::string faulty = install(opponent, run, "Faulty");
+
+    std::string output;
+    status = simulate("-comparative game_map=" TEST_MAPS_FOLDER "/input1.txt game_managers_folder=" +
+                      managers.string() + " algorithm1=" + aggressive + " algorithm2=" + faulty +
+                      " -isolated " + limits, output);
+    return output;
+}
+
+} // namespace
+
+// A game whose tank crashes takes down only its worker: the run completes and
+// leaves that game out
+TEST(simulator_isolated_leaves_out_a_crashed_game) {
+    int status = 0;
+    const std::string output = isolatedAgainst(CRASHING_LIBRARY, "", status);
+    CHECK_EQ(status, 0);
+    CHECK(output.find("killed its worker (Segmentation fault); left out of the results") != std::string::npos);
+}
+
+// A game whose tank never returns is stopped at worker_cpu_seconds
+TEST(simulator_isolated_stops_a_game_over_its_cpu_limit) {
+    int status = 0;
+    const std::string output = isolatedAgainst(SPINNING_LIBRARY, "worker_cpu_seconds=1", status);
+    CHECK_EQ(status, 0);
+    CHECK(output.find("exceeded its CPU time limit; left out of the results") != std::string::npos);
+}
+
+namespace {
+
+// The maps, game managers and algorithms of a run, copied into scratch/<name>:
+// input1.txt and input3.txt, two copies of the game manager and two of
+// Aggressive, which plays the same game every time (a competition takes the
+// libraries whose names contain "Algorithm")
+struct RunFolders {
+    fs::path maps, managers, algorithms;
+
+    explicit RunFolders(const std::string& name) {
+        const fs::path run = scratch(name);
+        maps = run / "maps";
+        managers = run / "game_managers";
+        algorithms = run / "algorithms";
+        for (const fs::path& folder : {maps, managers, algorithms}) fs::create_directories(folder);
+        for (const char* map : {"input1.txt", "input3.txt"}) {
+            fs::copy_file(fs::path(TEST_MAPS_FOLDER) / map, maps / map);
+        }
+        install(GAME_MANAGER_LIBRARY, managers, "GameManagerA");
+        install(GAME_MANAGER_LIBRARY, managers, "GameManagerB");
+        install(AGGRESSIVE_LIBRARY, algorithms, "Algorithm_AggressiveA");
+        install(AGGRESSIVE_LIBRARY, algorithms, "Algorithm_AggressiveB");
+    }
+
+    std::string competition() const {
+        return "-competition game_maps_folder=" + maps.string() + " game_manager=" +
+               (managers / "GameManagerA.so").string() + " algorithms_folder=" + algorithms.string();
+    }
+
+    std::string comparative() const {
+        return "-comparative game_map=" + (maps / "input1.txt").string() + " game_managers_folder=" +
+               managers.string() + " algorithm1=" + (algorithms / "Algorithm_AggressiveA.so").string() +
+               " algorithm2=" + (algorithms / "Algorithm_AggressiveB.so").string();
+    }
+};
+
+// Run `arguments` whole, then in `shards` parts and merge them; the result
+// file, starting with `prefix` in `folder`, must come out the same
+void checkShardedRun(const std::string& arguments, const std::string& prefix, const fs::path& folder, int shards) {
+    std::string output;
+    CHECK_EQ(simulate(arguments, output), 0);
+    const fs::path whole = resultFile(folder, prefix);
+    CHECK(!whole.empty());
+    if (whole.empty()) return;
+    const std::string expected = readFile(whole);
+    fs::remove(whole);
+
+    for (int shard = 0; shard < shards; ++shard) {
+        CHECK_EQ(simulate(arguments + " shard=" + std::to_string(shard) + "/" + std::to_string(shards), output), 0);
+    }
+    CHECK(resultFile(folder, prefix).empty());  // shards write only .shard files
+    CHECK_EQ(simulate("-merge shards_folder=" + folder.string(), output), 0);
+
+    const fs::path merged = resultFile(folder, prefix);
+    CHECK(!merged.empty());
+    if (!merged.empty()) {
+        CHECK_EQ(readFile(merged), expected);
+    }
+}
+
+} // namespace
+
+// Merging the .shard files of every part of a competition writes the result
+// file the whole run writes, also when a part has no games of its own
+TEST(simulator_shards_merge_into_the_competition_results) {
+    const RunFolders run("competition");
+    checkShardedRun(run.competition(), "competition_", run.algorithms, 3);
+}
+
+TEST(simulator_shards_merge_into_the_comparative_results) {
+    const RunFolders run("comparative");
+    checkShardedRun(run.comparative(), "comparative_results_", run.managers, 2);
+}
+
+// -merge refuses an incomplete set of shards
+TEST(simulator_shards_merge_needs_every_shard) {
+    const RunFolders sharded("partial_competition");
+    std::string output;
+    CHECK_EQ(simulate(sharded.competition() + " shard=1/2", output), 0);
+    CHECK(simulate("-merge shards_folder=" + sharded.algorithms.string(), output) != 0);
+    CHECK(output.find("missing shard(s) 0 of 2") != std::string::npos);
+}
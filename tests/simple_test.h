@@ -0,0 +1,62 @@
+// simple_test.h - A minimal registry of test cases and the checks they make
+#ifndef TESTS_SIMPLE_TEST_H
+#define TESTS_SIMPLE_TEST_H
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace simple_test {
+
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+// Every TEST of the executable, in no particular order
+std::vector<TestCase>& registry();
+
+struct Registration {
+    Registration(const char* name, void (*run)()) { registry().push_back({name, run}); }
+};
+
+// Record a failed check of the running test; it goes on with its other checks
+void fail(const char* file, int line, const std::string& what);
+
+template <typename T>
+std::string show(const T& value) {
+    std::ostringstream out;
+    if constexpr (std::is_enum_v<T>) {
+        out << static_cast<long long>(value);
+    } else {
+        out << value;
+    }
+    return out.str();
+}
+
+} // namespace simple_test
+
+// A test case; test_main runs those whose name starts with one of its arguments
+#define TEST(name)                                                              \
+    static void test_##name();                                                  \
+    static simple_test::Registration register_##name(#name, test_##name);       \
+    static void test_##name()
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition)) simple_test::fail(__FILE__, __LINE__, #condition);    \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                              \
+    do {                                                                        \
+        const auto& actual_ = (actual);                                         \
+        const auto& expected_ = (expected);                                     \
+        if (!(actual_ == expected_)) {                                          \
+            simple_test::fail(__FILE__, __LINE__,                               \
+                              #actual " == " #expected " (" + simple_test::show(actual_) + \
+                              " vs " + simple_test::show(expected_) + ")");     \
+        }                                                                       \
+    } while (0)
+
+#endif // TESTS_SIMPLE_TEST_H
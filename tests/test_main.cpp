@@ -0,0 +1,51 @@
+#include "simple_test.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace simple_test {
+
+std::vector<TestCase>& registry() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+namespace {
+size_t failures = 0;  // failed checks of the running test
+} // namespace
+
+void fail(const char* file, int line, const std::string& what) {
+    ++failures;
+    std::cerr << file << ":" << line << ": check failed: " << what << std::endl;
+}
+
+} // namespace simple_test
+
+// Runs every test whose name starts with one of the arguments (all of them
+// when there are none), in name order. Exits 1 if any check failed or no test
+// matched.
+int main(int argc, char* argv[]) {
+    auto tests = simple_test::registry();
+    std::sort(tests.begin(), tests.end(),
+              [](const simple_test::TestCase& a, const simple_test::TestCase& b) {
+                  return std::strcmp(a.name, b.name) < 0;
+              });
+
+    size_t ran = 0, failed = 0;
+    for (const auto& test : tests) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc && !selected; ++i) {
+            selected = std::strncmp(test.name, argv[i], std::strlen(argv[i])) == 0;
+        }
+        if (!selected) continue;
+
+        simple_test::failures = 0;
+        test.run();
+        ++ran;
+        if (simple_test::failures) ++failed;
+        std::cout << (simple_test::failures ? "FAIL " : "ok   ") << test.name << std::endl;
+    }
+
+    std::cout << ran - failed << " of " << ran << " tests passed" << std::endl;
+    return ran > 0 && failed == 0 ? 0 : 1;
+}